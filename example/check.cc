@@ -0,0 +1,60 @@
+// small thresholds and a few workers, so that the parallel paths run
+// even on a single core
+#define FNC_SCHEDULER_THREADS 3
+#define FNC_PARALLEL_SORT_THRESHOLD 1024
+
+#include <cassert>
+#include <iostream>
+#include <functional>
+#include "../src/collection.h"
+
+using namespace fnc;
+
+/*
+ * Regression checks, run by `make check`: each one aborts on failure.
+ */
+
+void bloom_copies()
+{
+    // every copy lands on a differently aligned buffer: none of them may
+    // lose a member
+    fvec<int> members = vrange(0,1000,1);
+    bloom<int> filter(members);
+    fvec<bloom<int>> copies;
+    for (int i = 0; i < 50; ++i) {
+        copies.push_back(i == 0 ? filter : copies.back());
+        bloom<int> assigned(1);
+        assigned = copies.back();
+        for (auto const &m: members) {
+            assert(copies.back().possibly_contains(m));
+            assert(assigned.possibly_contains(m));
+        }
+    }
+}
+
+void sort_across_scopes()
+{
+    // the runs of a parallel list_sort must share the allocator of the
+    // list, not pick the scope current when sorting
+    mem_scope build("build");
+    tracked_list<int> l;
+    for (int i = 0; i < 300000; ++i) {
+        l.push_back(static_cast<int>(i * 7919LL % 300000));
+    }
+    {
+        mem_scope sort("sort");
+        list_sort(l,std::less<int>());
+    }
+    int expected = 0;
+    for (auto const &i: l) {
+        assert(i == expected++);
+    }
+    assert(l.get_allocator().account() == mem_scope::current());
+}
+
+int main()
+{
+    bloom_copies();
+    sort_across_scopes();
+    std::cout << "All checks passed" << std::endl;
+}
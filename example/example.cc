@@ -92,12 +92,9 @@ void flist_example()
     std::cout << std::endl << std::endl;
 
     std::cout << std::endl << "Zip ----------------" << std::endl << std::endl;
-    flist<flist<int>> z = l2.zip(filtered);
+    flist<std::tuple<int,int>> z = l2.zip(filtered);
     for (auto const &i: z) {
-        for (auto const &j: i) {
-            std::cout << j << " ";
-        }
-        std::cout << std::endl;
+        std::cout << std::get<0>(i) << " " << std::get<1>(i) << std::endl;
     }
     std::cout << std::endl << std::endl;
 }
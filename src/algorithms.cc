@@ -0,0 +1,220 @@
+/*
+ *  collection/src/algorithms.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <algorithm>
+
+namespace fnc {
+
+    /*
+     * The overloads taking std::true_type are the paths for contiguous
+     * (or reservable) containers, the ones taking std::false_type the
+     * generic paths.
+     */
+    template <typename C>
+    inline void reserve_for(C &to, std::size_t n, std::true_type)
+    {
+        to.reserve(to.size() + n);
+    }
+
+    template <typename C>
+    inline void reserve_for(C &, std::size_t, std::false_type) {}
+
+    template <typename C, typename It>
+    inline void append_range(C &to, It first, It last, std::true_type)
+    {
+        // vector::insert sizes the storage once, and copies the trivially
+        // copyable elements from a contiguous range with one memmove
+        to.insert(to.end(),first,last);
+    }
+
+    template <typename C, typename It>
+    inline void append_range(C &to, It first, It last, std::false_type)
+    {
+        // insert(end,value) is the one insertion fvec, flist and fset
+        // share; the end hint makes it constant time on sorted sets too
+        for (; first != last; ++first) {
+            to.insert(to.end(),*first);
+        }
+    }
+
+    template <typename C, typename It>
+    void append_range(C &to, It first, It last)
+    {
+        append_range(to,first,last,typename storage_traits<C>::contiguous());
+    }
+
+    template <typename C, typename S>
+    inline void append_all(C &to, const S &from, std::true_type)
+    {
+        append_range(to,from.data(),from.data() + from.size());
+    }
+
+    template <typename C, typename S>
+    inline void append_all(C &to, const S &from, std::false_type)
+    {
+        append_range(to,from.begin(),from.end());
+    }
+
+    template <typename C, typename S>
+    void append_all(C &to, const S &from)
+    {
+        append_all(to,from,typename storage_traits<S>::contiguous());
+    }
+
+    template <typename C, typename S>
+    inline void append_slice(C &to, const S &from, std::size_t start, std::size_t stop, std::true_type)
+    {
+        append_range(to,from.data() + start,from.data() + stop);
+    }
+
+    template <typename C, typename S>
+    inline void append_slice(C &to, const S &from, std::size_t start, std::size_t stop, std::false_type)
+    {
+        auto first = std::next(from.begin(),start);
+        append_range(to,first,std::next(first,stop - start));
+    }
+
+    template <typename C, typename S>
+    void append_slice(C &to, const S &from, std::size_t start, std::size_t stop)
+    {
+        stop = std::min(stop,static_cast<std::size_t>(from.size()));
+        if (start >= stop) return;
+        append_slice(to,from,start,stop,typename storage_traits<S>::contiguous());
+    }
+
+    template <typename C, typename S>
+    inline void append_reversed(C &to, const S &from, std::true_type)
+    {
+        typedef std::reverse_iterator<const typename S::value_type *> reversed;
+        append_range(to,reversed(from.data() + from.size()),reversed(from.data()));
+    }
+
+    template <typename C, typename S>
+    inline void append_reversed(C &to, const S &from, std::false_type)
+    {
+        append_range(to,from.rbegin(),from.rend());
+    }
+
+    template <typename C, typename S>
+    void append_reversed(C &to, const S &from)
+    {
+        append_reversed(to,from,typename storage_traits<S>::contiguous());
+    }
+
+    template <typename C, typename S, typename F>
+    inline void map_into(C &to, const S &from, F &f, std::true_type)
+    {
+        const typename S::value_type *p = from.data();
+        const typename S::value_type *end = p + from.size();
+        for (; p != end; ++p) {
+            to.insert(to.end(),f(*p));
+        }
+    }
+
+    template <typename C, typename S, typename F>
+    inline void map_into(C &to, const S &from, F &f, std::false_type)
+    {
+        for (auto const &i: from) {
+            to.insert(to.end(),f(i));
+        }
+    }
+
+    template <typename C, typename S, typename F>
+    void map_into(C &to, const S &from, F f)
+    {
+        reserve_for(to,from.size(),typename storage_traits<C>::reservable());
+        map_into(to,from,f,typename storage_traits<S>::contiguous());
+    }
+
+    template <typename C, typename S, typename P>
+    void filter_into(C &to, const S &from, P predicate)
+    {
+        for (auto const &i: from) {
+            if (predicate(i))
+                to.insert(to.end(),i);
+        }
+    }
+
+    /*
+     * The contiguous path of `accumulate` keeps four independent
+     * accumulators, so the compiler can keep them in one vector register.
+     * It is taken only for integers: reassociating a floating point sum
+     * would change its result.
+     */
+    template <typename T, typename Op>
+    inline T accumulate(const T *p, const T *end, T base, Op op, T identity, std::true_type)
+    {
+        T acc[4] = {base,identity,identity,identity};
+        for (; end - p >= 4; p += 4) {
+            acc[0] = op(acc[0],p[0]);
+            acc[1] = op(acc[1],p[1]);
+            acc[2] = op(acc[2],p[2]);
+            acc[3] = op(acc[3],p[3]);
+        }
+        for (; p != end; ++p) {
+            acc[0] = op(acc[0],*p);
+        }
+        return op(op(acc[0],acc[1]),op(acc[2],acc[3]));
+    }
+
+    template <typename It, typename T, typename Op>
+    inline T accumulate(It first, It last, T base, Op op, T, std::false_type)
+    {
+        T acc = base;
+        for (; first != last; ++first) {
+            acc = op(acc,*first);
+        }
+        return acc;
+    }
+
+    template <typename S, typename T, typename Op>
+    inline T accumulate(const S &from, T base, Op op, T identity, std::true_type)
+    {
+        typedef std::integral_constant<bool,std::is_integral<T>::value &&
+                                            std::is_same<T,typename S::value_type>::value> unrolled;
+        return accumulate(from.data(),from.data() + from.size(),base,op,identity,unrolled());
+    }
+
+    template <typename S, typename T, typename Op>
+    inline T accumulate(const S &from, T base, Op op, T identity, std::false_type)
+    {
+        return accumulate(from.begin(),from.end(),base,op,identity,std::false_type());
+    }
+
+    template <typename S, typename T>
+    T accumulate_sum(const S &from, T base)
+    {
+        return accumulate(from,base,[](const T &x, const T &y) { return x + y; },T(0),
+                          typename storage_traits<S>::contiguous());
+    }
+
+    template <typename S, typename T>
+    T accumulate_product(const S &from, T base)
+    {
+        return accumulate(from,base,[](const T &x, const T &y) { return x * y; },T(1),
+                          typename storage_traits<S>::contiguous());
+    }
+
+    inline std::uint64_t mix64(std::uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    inline std::uint64_t splitmix64(std::uint64_t &x)
+    {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ *  collection/src/algorithms.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef algorithms_h
+#define algorithms_h
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+namespace fnc {
+
+    /*
+     * The operators shared by fvec, flist and fset are written once here,
+     * on top of what the storage of a container guarantees:
+     *
+     *  - contiguous: the elements are in one array (std::vector, fvec),
+     *    so the algorithms work on raw pointers; for trivially copyable
+     *    elements the copies become a memmove and the loops vectorize;
+     *  - reservable: the container has reserve(n), so the output is
+     *    allocated once when its final size is known;
+     *  - any other container is read through its iterators and written
+     *    with insert(end,value).
+     *
+     * Every container gets the fastest path its storage allows, and an
+     * improvement here applies to all of them.
+     */
+    template <typename T, typename A>
+    std::true_type is_vector_storage(const std::vector<T,A> *);
+    std::false_type is_vector_storage(...);
+
+    template <typename C>
+    auto has_reserve(int) -> decltype(std::declval<C &>().reserve(0),std::true_type());
+    template <typename C>
+    std::false_type has_reserve(...);
+
+    template <typename C>
+    struct storage_traits {
+        typedef decltype(is_vector_storage(std::declval<const C *>())) contiguous;
+        typedef decltype(has_reserve<C>(0)) reservable;
+    };
+
+    /*
+     * `append_range` appends [first,last) at the end of `to`.
+     */
+    template <typename C, typename It>
+    void append_range(C &to, It first, It last);
+
+    /*
+     * `append_all` appends all the elements of `from` at the end of `to`.
+     */
+    template <typename C, typename S>
+    void append_all(C &to, const S &from);
+
+    /*
+     * `append_slice` appends the elements of `from` in the positions
+     * [start,stop) at the end of `to`; the bounds are clamped to the size
+     * of `from`.
+     */
+    template <typename C, typename S>
+    void append_slice(C &to, const S &from, std::size_t start, std::size_t stop);
+
+    /*
+     * `append_reversed` appends the elements of `from`, from the last one
+     * to the first one, at the end of `to`.
+     */
+    template <typename C, typename S>
+    void append_reversed(C &to, const S &from);
+
+    /*
+     * `map_into` appends f(x) for each element x of `from` at the end of
+     * `to`.
+     */
+    template <typename C, typename S, typename F>
+    void map_into(C &to, const S &from, F f);
+
+    /*
+     * `filter_into` appends the elements of `from` that fullfill the
+     * predicate at the end of `to`.
+     */
+    template <typename C, typename S, typename P>
+    void filter_into(C &to, const S &from, P predicate);
+
+    /*
+     * `accumulate_sum` and `accumulate_product` fold the elements of
+     * `from` with (+) and (*), starting from `base`.
+     */
+    template <typename S, typename T>
+    T accumulate_sum(const S &from, T base);
+
+    template <typename S, typename T>
+    T accumulate_product(const S &from, T base);
+
+    /*
+     * `mix64` is the finalizer of murmur3: every bit of `h` affects every
+     * bit of the result. The hashed containers run std::hash, often the
+     * identity, through it.
+     */
+    inline std::uint64_t mix64(std::uint64_t h);
+
+    /*
+     * `splitmix64` advances `x` and returns the next number of the
+     * splitmix64 sequence, a good way to expand a seed.
+     */
+    inline std::uint64_t splitmix64(std::uint64_t &x);
+
+}
+
+#include "algorithms.cc"
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ *  collection/src/bloom.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T, typename Hash>
+    const std::size_t bloom<T,Hash>::words_per_block;
+
+    template <typename T, typename Hash>
+    bloom<T,Hash>::bloom(std::size_t expected, double fp_rate)
+    {
+        init(expected,fp_rate);
+    }
+
+    template <typename T, typename Hash>
+    template <typename C, typename>
+    bloom<T,Hash>::bloom(const C &container, double fp_rate)
+    {
+        init(std::distance(std::begin(container),std::end(container)),fp_rate);
+        for (auto const &i: container) {
+            this->add(i);
+        }
+    }
+
+    template <typename T, typename Hash>
+    bloom<T,Hash>::bloom(const bloom<T,Hash> &other)
+        : words(other.words.size(),0), block_count(other.block_count), k(other.k), hasher(other.hasher)
+    {
+        align();
+        std::copy(other.words.begin() + other.offset,
+                  other.words.begin() + other.offset + block_count * words_per_block,
+                  words.begin() + offset);
+    }
+
+    template <typename T, typename Hash>
+    bloom<T,Hash> &bloom<T,Hash>::operator=(const bloom<T,Hash> &other)
+    {
+        if (this != &other) {
+            bloom<T,Hash> copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Hash>
+    void bloom<T,Hash>::add(T elem)
+    {
+        std::uint64_t h = hash_of(elem);
+        std::uint64_t *block = words.data() + offset
+            + ((h >> 32) * block_count >> 32) * words_per_block;
+
+        // the high half of the hash picks the block, 9-bit slices of a
+        // remixed hash pick the bits inside it
+        std::uint64_t g = h;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (i % 7 == 0) g = g * 0x9e3779b97f4a7c15ULL + 1;
+            std::size_t bit = (g >> (9 * (i % 7))) & 511;
+            block[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+        }
+    }
+
+    template <typename T, typename Hash>
+    bool bloom<T,Hash>::possibly_contains(T elem) const
+    {
+        std::uint64_t h = hash_of(elem);
+        const std::uint64_t *block = words.data() + offset
+            + ((h >> 32) * block_count >> 32) * words_per_block;
+
+        std::uint64_t g = h;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (i % 7 == 0) g = g * 0x9e3779b97f4a7c15ULL + 1;
+            std::size_t bit = (g >> (9 * (i % 7))) & 511;
+            if ((block[bit >> 6] & (std::uint64_t(1) << (bit & 63))) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, typename Hash>
+    void bloom<T,Hash>::clear()
+    {
+        std::fill(words.begin(),words.end(),0);
+    }
+
+    template <typename T, typename Hash>
+    inline std::size_t bloom<T,Hash>::hashes() const { return k; }
+
+    template <typename T, typename Hash>
+    inline std::size_t bloom<T,Hash>::size_in_bytes() const
+    {
+        return block_count * words_per_block * sizeof(std::uint64_t);
+    }
+
+    template <typename T, typename Hash>
+    void bloom<T,Hash>::init(std::size_t expected, double fp_rate)
+    {
+        if (fp_rate <= 0 || fp_rate >= 1) throw "fp_rate must be in the range (0,1)";
+
+        // optimal bits per element and number of hashes for a classic
+        // filter; blocking costs a little accuracy, so 10% more bits.
+        const double ln2 = std::log(2.0);
+        double bits_per_elem = -std::log(fp_rate) / (ln2 * ln2) * 1.1;
+
+        k = static_cast<std::size_t>(std::round(bits_per_elem / 1.1 * ln2));
+        k = std::min<std::size_t>(std::max<std::size_t>(k,1),16);
+
+        double bits = std::max<double>(expected,1) * bits_per_elem;
+        block_count = static_cast<std::size_t>(std::ceil(bits / 512));
+        block_count = std::max<std::size_t>(block_count,1);
+
+        // one spare block to align the first one on a cache line
+        words.assign((block_count + 1) * words_per_block,0);
+        align();
+    }
+
+    template <typename T, typename Hash>
+    void bloom<T,Hash>::align()
+    {
+        // the offset is fixed with the buffer: a moved vector keeps its
+        // buffer, a copied one gets a new buffer and a new offset
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(words.data());
+        offset = ((64 - address % 64) % 64) / sizeof(std::uint64_t);
+    }
+
+    template <typename T, typename Hash>
+    inline std::uint64_t bloom<T,Hash>::hash_of(const T &elem) const
+    {
+        return mix64(static_cast<std::uint64_t>(hasher(elem)));
+    }
+}
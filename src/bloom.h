@@ -0,0 +1,101 @@
+/*
+ *  collection/src/bloom.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef bloom_h
+#define bloom_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include "algorithms.h"
+
+namespace fnc {
+
+    /*
+     * `bloom` is a blocked Bloom filter: a probabilistic set that can
+     * answer "definitely not a member" or "possibly a member".
+     *
+     * The bit array is split into 64-byte blocks, one cache line each, and
+     * all the bits of an element live in the same block, so a query costs
+     * a single cache miss. It is meant as a pre-filter for `any`, `except`
+     * and `intersecate` of fvec, flist and fset: most non-members are
+     * rejected before the exact (and much more expensive) lookup.
+     *
+     * Example:
+     *
+     *     fset<int> big = ...;
+     *     bloom<int> filter(big, 0.01);
+     *     fvec<int> missing = candidates.except(big, filter);
+     */
+    template <typename T, typename Hash = std::hash<T> >
+    class bloom {
+
+    public :
+        /*
+         * - expected : the number of elements that will be added;
+         * - fp_rate : the target false-positive rate, in (0,1).
+         */
+        bloom(std::size_t expected, double fp_rate = 0.01);
+
+        /*
+         * Builds the filter from every element of `container` (an fvec,
+         * an flist, an fset or anything with begin() and end()).
+         */
+        template <typename C,
+                  typename = decltype(std::begin(std::declval<const C &>()))>
+        bloom(const C &container, double fp_rate = 0.01);
+
+        /*
+         * A copy realigns the blocks on its own buffer.
+         */
+        bloom(const bloom<T,Hash> &other);
+
+        bloom(bloom<T,Hash> &&other) = default;
+
+        bloom<T,Hash> &operator=(const bloom<T,Hash> &other);
+
+        bloom<T,Hash> &operator=(bloom<T,Hash> &&other) = default;
+
+        void add(T elem);
+
+        /*
+         * `possibly_contains` returns false only if `elem` was never added.
+         */
+        bool possibly_contains(T elem) const;
+
+        void clear();
+
+        /*
+         * `hashes` returns the number of bits set per element.
+         */
+        inline std::size_t hashes() const;
+
+        inline std::size_t size_in_bytes() const;
+
+    private :
+        static const std::size_t words_per_block = 8;
+
+        std::vector<std::uint64_t> words;
+        std::size_t offset;
+        std::size_t block_count;
+        std::size_t k;
+        Hash hasher;
+
+        void init(std::size_t expected, double fp_rate);
+        void align();
+        inline std::uint64_t hash_of(const T &elem) const;
+    };
+
+}
+
+#include "bloom.cc"
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ *  collection/src/channel.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+
+namespace fnc {
+
+    template <typename T>
+    channel<T>::channel(std::size_t capacity)
+        : max_size(capacity), is_closed(false), is_cancelled(false)
+    {
+        if (capacity == 0) throw "The capacity of a channel must be greater than 0";
+    }
+
+    template <typename T>
+    inline std::size_t channel<T>::capacity() const { return max_size; }
+
+    template <typename T>
+    bool channel<T>::push(T elem)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock,[this]() {
+            return buffer.size() < max_size || is_closed || is_cancelled;
+        });
+        if (is_closed || is_cancelled) return false;
+
+        buffer.push_back(std::move(elem));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    template <typename T>
+    bool channel<T>::push_all(std::vector<T> &elems)
+    {
+        auto i = elems.begin();
+        while (i != elems.end()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_full.wait(lock,[this]() {
+                return buffer.size() < max_size || is_closed || is_cancelled;
+            });
+            if (is_closed || is_cancelled) return false;
+
+            for (; i != elems.end() && buffer.size() < max_size; ++i) {
+                buffer.push_back(std::move(*i));
+            }
+            lock.unlock();
+            not_empty.notify_all();
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool channel<T>::pop(T &elem)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock,[this]() {
+            return !buffer.empty() || is_closed || is_cancelled;
+        });
+        if (is_cancelled || buffer.empty()) return false;
+
+        elem = std::move(buffer.front());
+        buffer.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+
+    template <typename T>
+    std::size_t channel<T>::pop_n(std::vector<T> &elems, std::size_t n)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock,[this]() {
+            return !buffer.empty() || is_closed || is_cancelled;
+        });
+        if (is_cancelled) return 0;
+
+        std::size_t popped = 0;
+        for (; popped < n && !buffer.empty(); ++popped) {
+            elems.push_back(std::move(buffer.front()));
+            buffer.pop_front();
+        }
+        lock.unlock();
+        not_full.notify_all();
+        return popped;
+    }
+
+    template <typename T>
+    void channel<T>::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+    template <typename T>
+    void channel<T>::cancel()
+    {
+        std::deque<T> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_cancelled = true;
+            dropped.swap(buffer);
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+    template <typename T>
+    bool channel<T>::closed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return is_closed || is_cancelled;
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ *  collection/src/channel.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef channel_h
+#define channel_h
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <condition_variable>
+
+namespace fnc {
+
+    /*
+     * `channel` is a bounded, blocking FIFO queue connecting a producer
+     * and a consumer running on different threads. It applies
+     * backpressure: a producer pushing into a full channel waits until
+     * the consumer makes room.
+     *
+     * A channel ends in one of two ways:
+     *  - `close`: the producer is done; the consumer still reads the
+     *    elements left, then `pop` returns false;
+     *  - `cancel`: the consumer is done (or something failed); the
+     *    elements left are dropped and both sides stop at once.
+     *
+     * Example:
+     *
+     *     auto ch = std::make_shared<channel<fvec<char>>>(16);
+     *     std::thread reader([ch]() {
+     *         fvec<char> chunk;
+     *         while (read_chunk(socket,chunk)) ch->push(chunk);
+     *         ch->close();
+     *     });
+     *     fvec<char> chunk;
+     *     while (ch->pop(chunk)) process(chunk);
+     */
+    template <typename T>
+    class channel {
+
+    public :
+        channel(std::size_t capacity);
+
+        channel(const channel<T> &other) = delete;
+
+        channel<T> &operator=(const channel<T> &other) = delete;
+
+        inline std::size_t capacity() const;
+
+        /*
+         * `push` appends `elem`, waiting while the channel is full. It
+         * returns false if the channel was closed or cancelled.
+         */
+        bool push(T elem);
+
+        /*
+         * `push_all` pushes the elements of `elems` in order, waiting for
+         * room whenever the channel is full, with one lock per run of
+         * elements that fits. It returns false if the channel was closed
+         * or cancelled before all of them were pushed.
+         */
+        bool push_all(std::vector<T> &elems);
+
+        /*
+         * `pop` moves the first element into `elem`, waiting while the
+         * channel is empty. It returns false once the channel is closed
+         * and drained, or cancelled.
+         */
+        bool pop(T &elem);
+
+        /*
+         * `pop_n` moves up to n elements at the end of `elems`, waiting
+         * until there is at least one, and returns how many they were:
+         * 0 once the channel is closed and drained, or cancelled.
+         */
+        std::size_t pop_n(std::vector<T> &elems, std::size_t n);
+
+        void close();
+
+        void cancel();
+
+        bool closed() const;
+
+    private :
+        mutable std::mutex mutex;
+        std::condition_variable not_full;
+        std::condition_variable not_empty;
+        std::deque<T> buffer;
+        std::size_t max_size;
+        bool is_closed;
+        bool is_cancelled;
+    };
+
+}
+
+#include "channel.cc"
+
+#endif
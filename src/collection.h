@@ -9,8 +9,31 @@
 #ifndef _collection_h_
 #define _collection_h_
 
+#include "algorithms.h"
+#include "pool_allocator.h"
+#include "unrolled_list.h"
 #include "flist.h"
 #include "fvec.h"
+#include "sorted_fvec.h"
+#include "fixed_fvec.h"
 #include "fset.h"
+#include "fset_os.h"
+#include "fhash_set.h"
+#include "bloom.h"
+#include "fpset.h"
+#include "fcons.h"
+#include "fqueue.h"
+#include "fseq.h"
+#include "fstream.h"
+#include "transducer.h"
+#include "channel.h"
+#include "pipeline.h"
+#include "scheduler.h"
+#include "scan.h"
+#include "join.h"
+#include "zip.h"
+#include "sketch.h"
+#include "random.h"
+#include "mem_scope.h"
 
 #endif /* _collection_h_ */
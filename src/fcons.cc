@@ -0,0 +1,350 @@
+/*
+ *  collection/src/fcons.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T>
+    fcons<T>::fcons() : first(nullptr) {}
+
+    template <typename T>
+    fcons<T>::fcons(std::initializer_list<T> l) : first(nullptr)
+    {
+        for (auto i = l.end(); i != l.begin(); ) {
+            --i;
+            first = std::make_shared<cell>(*i,first);
+        }
+    }
+
+    template <typename T>
+    fcons<T>::fcons(std::list<T> l) : first(nullptr)
+    {
+        for (auto i = l.rbegin(); i != l.rend(); ++i) {
+            first = std::make_shared<cell>(*i,first);
+        }
+    }
+
+    template <typename T>
+    fcons<T>::fcons(cell_ptr first) : first(first) {}
+
+    template <typename T>
+    fcons<T>::~fcons() { release(first); }
+
+    template <typename T>
+    fcons<T> &fcons<T>::operator=(fcons<T> other)
+    {
+        std::swap(first,other.first);
+        return *this;
+    }
+
+    template <typename T>
+    inline bool fcons<T>::empty() const { return first == nullptr; }
+
+    template <typename T>
+    inline std::size_t fcons<T>::size() const { return first ? first->length : 0; }
+
+    template <typename T>
+    fcons<T> fcons<T>::cons(T elem) const
+    {
+        return fcons<T>(std::make_shared<cell>(elem,first));
+    }
+
+    template <typename T>
+    inline T fcons<T>::head() const
+    {
+        if (this->empty()) throw "ERROR: empty list";
+        return first->value;
+    }
+
+    template <typename T>
+    inline fcons<T> fcons<T>::tail() const
+    {
+        if (this->empty()) throw "ERROR: empty list";
+        return fcons<T>(first->next);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::drop(int n) const
+    {
+        const cell *p = first.get();
+        cell_ptr const *link = &first;
+        for (int i = 0; i < n && p != nullptr; ++i) {
+            link = &p->next;
+            p = p->next.get();
+        }
+        return fcons<T>(*link);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::take(int n) const
+    {
+        if (n >= static_cast<int>(this->size())) return *this;
+
+        builder b;
+        const cell *p = first.get();
+        for (int i = 0; i < n; ++i) {
+            b.push_back(p->value);
+            p = p->next.get();
+        }
+        return b.finish(nullptr);
+    }
+
+    template <typename T>
+    T fcons<T>::last() const
+    {
+        if (this->empty()) throw "ERROR: empty list";
+
+        const cell *p = first.get();
+        while (p->next) p = p->next.get();
+        return p->value;
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::init() const
+    {
+        if (this->empty()) throw "ERROR: empty list";
+        return this->take(static_cast<int>(this->size()) - 1);
+    }
+
+    template <typename T>
+    flist<T> fcons<T>::to_flist() const
+    {
+        flist<T> list;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            list.push_back(p->value);
+        }
+        return list;
+    }
+
+    template <typename T>
+    T fcons<T>::foldr(std::function<T(T,T)> f, T base) const
+    {
+        std::vector<const cell *> cells;
+        cells.reserve(this->size());
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            cells.push_back(p);
+        }
+
+        T acc = base;
+        for (auto i = cells.rbegin(); i != cells.rend(); ++i) {
+            acc = f((*i)->value,acc);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    T fcons<T>::foldl(std::function<T(T,T)> f, T base) const
+    {
+        T acc = base;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            acc = f(acc,p->value);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::scanl(std::function<T(T,T)> f, T base) const
+    {
+        builder b;
+        T acc = base;
+        b.push_back(acc);
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            acc = f(acc,p->value);
+            b.push_back(acc);
+        }
+        return b.finish(nullptr);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::map(std::function<T(T)> f) const
+    {
+        builder b;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            b.push_back(f(p->value));
+        }
+        return b.finish(nullptr);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::filter(std::function<bool(T)> predicate) const
+    {
+        std::vector<bool> keep;
+        keep.reserve(this->size());
+        cell_ptr const *shared = &first;
+
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            keep.push_back(predicate(p->value));
+            if (!keep.back()) shared = &p->next;
+        }
+
+        builder b;
+        std::size_t i = 0;
+        for (const cell *p = first.get(); p != shared->get(); p = p->next.get(), ++i) {
+            if (keep[i]) b.push_back(p->value);
+        }
+        return b.finish(*shared);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::concat(fcons<T> other) const
+    {
+        if (other.empty()) return *this;
+
+        builder b;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            b.push_back(p->value);
+        }
+        return b.finish(other.first);
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::reverse() const
+    {
+        fcons<T> reversed;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            reversed = reversed.cons(p->value);
+        }
+        return reversed;
+    }
+
+    template <typename T>
+    bool fcons<T>::any(T elem) const
+    {
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            if (p->value == elem) return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::singleton(T element) const
+    {
+        return fcons<T>().cons(element);
+    }
+
+    template <typename T>
+    T fcons<T>::sum() const
+    {
+        T sum = 0;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            sum += p->value;
+        }
+        return sum;
+    }
+
+    template <typename T>
+    T fcons<T>::product() const
+    {
+        T product = 1;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            product *= p->value;
+        }
+        return product;
+    }
+
+    template <typename T>
+    T fcons<T>::min() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty list";
+        return std::get<0>(this->minmax());
+    }
+
+    template <typename T>
+    T fcons<T>::max() const
+    {
+        if (this->empty()) throw "Cannot calculate the maximum of an empty list";
+        return std::get<1>(this->minmax());
+    }
+
+    template <typename T>
+    std::tuple<T,T> fcons<T>::minmax() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty list";
+
+        T min = first->value;
+        T max = first->value;
+        for (const cell *p = first->next.get(); p != nullptr; p = p->next.get()) {
+            if (p->value < min) min = p->value;
+            if (max < p->value) max = p->value;
+        }
+        return std::make_tuple(min,max);
+    }
+
+    template <typename T>
+    void fcons<T>::foreach(std::function<void(T)> action) const
+    {
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            action(p->value);
+        }
+    }
+
+    template <typename T>
+    template <typename U>
+    fcons<U> fcons<T>::select(std::function<U(T)> selector) const
+    {
+        typename fcons<U>::builder b;
+        for (const cell *p = first.get(); p != nullptr; p = p->next.get()) {
+            b.push_back(selector(p->value));
+        }
+        return b.finish(nullptr);
+    }
+
+    template <typename T>
+    void fcons<T>::release(cell_ptr &p)
+    {
+        // letting shared_ptr destroy the chain would recurse once per cell;
+        // the cells are only const through cell_ptr, so moving out is safe
+        cell_ptr q = std::move(p);
+        while (q && q.use_count() == 1) {
+            cell_ptr next = std::move(const_cast<cell &>(*q).next);
+            q = std::move(next);
+        }
+    }
+
+    template <typename T>
+    fcons<T>::builder::builder() : first(nullptr), last(nullptr), count(0) {}
+
+    template <typename T>
+    fcons<T>::builder::~builder()
+    {
+        cell_ptr p = std::move(first);
+        release(p);
+    }
+
+    template <typename T>
+    void fcons<T>::builder::push_back(T elem)
+    {
+        std::shared_ptr<cell> c = std::make_shared<cell>(elem,nullptr);
+        if (last == nullptr)
+            first = c;
+        else
+            last->next = c;
+        last = c.get();
+        count++;
+    }
+
+    template <typename T>
+    fcons<T> fcons<T>::builder::finish(cell_ptr tail)
+    {
+        if (last == nullptr) return fcons<T>(tail);
+
+        std::size_t length = count + (tail ? tail->length : 0);
+        last->next = tail;
+        for (const cell *p = first.get(); length > 0 && p != tail.get(); p = p->next.get()) {
+            const_cast<cell *>(p)->length = length--;
+        }
+
+        fcons<T> list(cell_ptr(std::move(first)));
+        last = nullptr;
+        count = 0;
+        return list;
+    }
+}
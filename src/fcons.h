@@ -0,0 +1,233 @@
+/*
+ *  collection/src/fcons.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fcons_h
+#define fcons_h
+
+#include <list>
+#include <tuple>
+#include <memory>
+#include <functional>
+#include <initializer_list>
+#include "flist.h"
+
+namespace fnc {
+
+    /*
+     * `fcons` is a persistent (immutable) singly linked list, made of
+     * reference-counted cons cells, like the lists of Haskell or Lisp.
+     *
+     * Lists share their tails: `cons`, `head` and `tail` are O(1), `drop`
+     * walks n cells without allocating, and the operators only allocate
+     * the cells they actually create (e.g. `filter` shares the suffix
+     * after the last rejected element, `concat` shares `other`).
+     *
+     * Example:
+     *
+     *     fcons<int> xs({2,3});
+     *     fcons<int> ys = xs.cons(1);    // [1,2,3], shares [2,3] with xs
+     */
+    template <typename T>
+    class fcons {
+
+    public :
+        fcons();
+
+        fcons(std::initializer_list<T> l);
+
+        fcons(std::list<T> l);
+
+        fcons(const fcons<T> &other) = default;
+
+        fcons(fcons<T> &&other) = default;
+
+        ~fcons();
+
+        fcons<T> &operator=(fcons<T> other);
+
+        inline bool empty() const;
+
+        /*
+         * `size` returns the length of the list in O(1).
+         */
+        inline std::size_t size() const;
+
+        /*
+         * `cons` returns the list with `elem` prepended, in O(1).
+         */
+        fcons<T> cons(T elem) const;
+
+        /*
+         * `head` returns the first element of the fcons.
+         */
+        inline T head() const;
+
+        /*
+         * `tail` returns the fcons with the first element dropped, in O(1).
+         */
+        inline fcons<T> tail() const;
+
+        /*
+         * `drop` drops the first n elements of the fcons, in O(n) and
+         * without allocating.
+         */
+        fcons<T> drop(int n) const;
+
+        /*
+         * `take` returns the first n elements of the fcons.
+         */
+        fcons<T> take(int n) const;
+
+        /*
+         * `last` returns the last element of the fcons.
+         */
+        T last() const;
+
+        /*
+         * `init` returns the fcons with the last element dropped.
+         */
+        fcons<T> init() const;
+
+        flist<T> to_flist() const;
+
+        /*
+         * - f : a function;
+         * - base : a starting value (typically the right-identity of the
+         *          function;
+         * `foldr` reduces the list by applying `f` in a right-associative way
+         *
+         *     f(x1, f(x2, ... f(xn, base)))
+         */
+        T foldr(std::function<T(T,T)> f, T base) const;
+
+        /*
+         * - f : a function;
+         * - base : a starting value (typically the left-identity of the
+         *          function;
+         * `foldl` reduces the list by applying `f` in a left-associative way
+         *
+         *     f(... f(f(base, x1), x2) ..., xn)
+         */
+        T foldl(std::function<T(T,T)> f, T base) const;
+
+        fcons<T> scanl(std::function<T(T,T)> f, T base) const;
+
+        /*
+         * `map` applies to each element of the fcons the function
+         *
+         *    f: T --> T
+         *
+         * and then returns the fcons of mapped elements.
+         */
+        fcons<T> map(std::function<T(T)> f) const;
+
+        /*
+         * `filter` returns an fcons with the elements that fullfill the
+         * predicate function
+         *
+         *    f: T --> bool
+         *
+         * The suffix that follows the last rejected element is shared.
+         */
+        fcons<T> filter(std::function<bool(T)> predicate) const;
+
+        /*
+         * `concat` copies the cells of this list and shares `other`.
+         */
+        fcons<T> concat(fcons<T> other) const;
+
+        fcons<T> reverse() const;
+
+        bool any(T elem) const;
+
+        fcons<T> singleton(T element) const;
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        T sum() const;
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        T product() const;
+
+        /*
+         * `min` returns the minimum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T min() const;
+
+        /*
+         * `max` returns the maximum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T max() const;
+
+        /*
+         * `minmax` returns the tuple <min,max>.
+         */
+        std::tuple<T,T> minmax() const;
+
+        void foreach(std::function<void(T)> action) const;
+
+        template <typename U> fcons<U> select(std::function<U(T)> selector) const;
+
+    private :
+        template <typename U> friend class fcons;
+
+        struct cell {
+            T value;
+            std::shared_ptr<const cell> next;
+            std::size_t length;
+
+            cell(T value, std::shared_ptr<const cell> next)
+                : value(value), next(next), length(next ? next->length + 1 : 1) {}
+        };
+
+        typedef std::shared_ptr<const cell> cell_ptr;
+
+        cell_ptr first;
+
+        fcons(cell_ptr first);
+
+        /*
+         * `release` drops the cells of `p` that are not shared with other
+         * lists one by one, instead of recursively.
+         */
+        static void release(cell_ptr &p);
+
+        /*
+         * `builder` appends cells at the end of a list under construction;
+         * the lengths are fixed up by `finish`, once the tail is known.
+         */
+        class builder {
+
+        public :
+            builder();
+
+            ~builder();
+
+            void push_back(T elem);
+
+            fcons<T> finish(cell_ptr tail);
+
+        private :
+            std::shared_ptr<cell> first;
+            cell *last;
+            std::size_t count;
+        };
+    };
+
+}
+
+#include "fcons.cc"
+
+#endif
@@ -0,0 +1,518 @@
+/*
+ *  collection/src/fhash_set.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <new>
+#include <memory>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FNC_HASH_SET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fnc {
+
+    template <typename T, typename Hash, typename Eq>
+    const std::int8_t fhash_set<T,Hash,Eq>::empty_slot;
+
+    template <typename T, typename Hash, typename Eq>
+    const std::int8_t fhash_set<T,Hash,Eq>::deleted_slot;
+
+    template <typename T, typename Hash, typename Eq>
+    const std::size_t fhash_set<T,Hash,Eq>::group_width;
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::fhash_set()
+        : ctrl(nullptr), slots(nullptr), slot_count(0), count(0), growth_left(0) {}
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::fhash_set(std::initializer_list<T> l) : fhash_set()
+    {
+        this->reserve(l.size());
+        for (auto const &i: l) {
+            this->insert(i);
+        }
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::fhash_set(const fhash_set<T,Hash,Eq> &other)
+        : ctrl(nullptr), slots(nullptr), slot_count(0), count(0), growth_left(0),
+          hasher(other.hasher), equal(other.equal)
+    {
+        if (other.slot_count == 0) return;
+
+        allocate(other.slot_count);
+        std::memcpy(ctrl,other.ctrl,slot_count);
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (ctrl[i] >= 0)
+                new (slots + i) T(other.slots[i]);
+        }
+        count = other.count;
+        growth_left = other.growth_left;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::fhash_set(fhash_set<T,Hash,Eq> &&other)
+        : ctrl(other.ctrl), slots(other.slots), slot_count(other.slot_count),
+          count(other.count), growth_left(other.growth_left),
+          hasher(std::move(other.hasher)), equal(std::move(other.equal))
+    {
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.slot_count = other.count = other.growth_left = 0;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::~fhash_set() { release(); }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> &fhash_set<T,Hash,Eq>::operator=(fhash_set<T,Hash,Eq> other)
+    {
+        std::swap(ctrl,other.ctrl);
+        std::swap(slots,other.slots);
+        std::swap(slot_count,other.slot_count);
+        std::swap(count,other.count);
+        std::swap(growth_left,other.growth_left);
+        std::swap(hasher,other.hasher);
+        std::swap(equal,other.equal);
+        return *this;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::size_t fhash_set<T,Hash,Eq>::size() const { return count; }
+
+    template <typename T, typename Hash, typename Eq>
+    inline bool fhash_set<T,Hash,Eq>::empty() const { return count == 0; }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::size_t fhash_set<T,Hash,Eq>::capacity() const { return slot_count; }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator fhash_set<T,Hash,Eq>::begin() const
+    {
+        return iterator(this,0);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator fhash_set<T,Hash,Eq>::end() const
+    {
+        return iterator(this,slot_count);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fhash_set<T,Hash,Eq>::insert(T elem)
+    {
+        std::uint64_t h = hash_of(elem);
+        if (find_index(elem,h) != slot_count) return false;
+
+        if (slot_count == 0) rehash(group_width);
+
+        std::size_t i = find_free(h);
+        if (ctrl[i] == empty_slot && growth_left == 0) {
+            rehash(slot_count * 2);
+            i = find_free(h);
+        }
+
+        if (ctrl[i] == empty_slot) growth_left--;
+        new (slots + i) T(std::move(elem));
+        ctrl[i] = static_cast<std::int8_t>(h & 0x7F);
+        count++;
+        return true;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fhash_set<T,Hash,Eq>::erase(T elem)
+    {
+        std::size_t i = find_index(elem,hash_of(elem));
+        if (i == slot_count) return false;
+
+        slots[i].~T();
+        count--;
+
+        // A group that still has an empty slot has never been probed past,
+        // so the slot can go back to empty instead of becoming a tombstone.
+        const std::int8_t *group = ctrl + (i - i % group_width);
+        if (match_byte(group,empty_slot) != 0) {
+            ctrl[i] = empty_slot;
+            growth_left++;
+        } else {
+            ctrl[i] = deleted_slot;
+        }
+        return true;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::clear()
+    {
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (ctrl[i] >= 0)
+                slots[i].~T();
+        }
+        if (slot_count > 0) std::memset(ctrl,empty_slot,slot_count);
+        count = 0;
+        growth_left = slot_count - slot_count / 8;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::reserve(std::size_t n)
+    {
+        if (n > count + growth_left)
+            rehash(slots_for(n));
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::rehash(std::size_t n)
+    {
+        n = std::max(slots_for(count),std::max(n,group_width));
+        std::size_t new_count = group_width;
+        while (new_count < n) new_count *= 2;
+
+        std::int8_t *old_ctrl = ctrl;
+        T *old_slots = slots;
+        std::size_t old_count = slot_count;
+
+        allocate(new_count);
+        growth_left -= count;
+
+        for (std::size_t i = 0; i < old_count; ++i) {
+            if (old_ctrl[i] < 0) continue;
+
+            std::uint64_t h = hash_of(old_slots[i]);
+            std::size_t j = find_free(h);
+            new (slots + j) T(std::move(old_slots[i]));
+            ctrl[j] = static_cast<std::int8_t>(h & 0x7F);
+            old_slots[i].~T();
+        }
+
+        delete [] old_ctrl;
+        std::allocator<T>().deallocate(old_slots,old_count);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::copy() const
+    {
+        return fhash_set<T,Hash,Eq>(*this);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::map(std::function<T(T)> f) const
+    {
+        fhash_set<T,Hash,Eq> set;
+        set.reserve(count);
+        for (auto const &i: *this) {
+            set.insert(f(i));
+        }
+        return set;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::filter(std::function<bool(T)> predicate) const
+    {
+        fhash_set<T,Hash,Eq> set;
+        for (auto const &i: *this) {
+            if (predicate(i))
+                set.insert(i);
+        }
+        return set;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::unite(const fhash_set<T,Hash,Eq> &other) const
+    {
+        const fhash_set<T,Hash,Eq> &larger = count >= other.count ? *this : other;
+        const fhash_set<T,Hash,Eq> &smaller = count >= other.count ? other : *this;
+
+        fhash_set<T,Hash,Eq> united(larger);
+        united.reserve(larger.count + smaller.count);
+        for (auto const &i: smaller) {
+            united.insert(i);
+        }
+        return united;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::intersecate(const fhash_set<T,Hash,Eq> &other) const
+    {
+        const fhash_set<T,Hash,Eq> &larger = count >= other.count ? *this : other;
+        const fhash_set<T,Hash,Eq> &smaller = count >= other.count ? other : *this;
+
+        fhash_set<T,Hash,Eq> intersected;
+        for (auto const &i: smaller) {
+            if (larger.any(i))
+                intersected.insert(i);
+        }
+        return intersected;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::except(const fhash_set<T,Hash,Eq> &other) const
+    {
+        fhash_set<T,Hash,Eq> res;
+        for (auto const &i: *this) {
+            if (!other.any(i))
+                res.insert(i);
+        }
+        return res;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fhash_set<T,Hash,Eq>::any(T elem) const
+    {
+        return find_index(elem,hash_of(elem)) != slot_count;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq> fhash_set<T,Hash,Eq>::singleton(T element) const
+    {
+        fhash_set<T,Hash,Eq> set;
+        set.insert(element);
+        return set;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fhash_set<T,Hash,Eq>::sum() const
+    {
+        T sum = 0;
+
+        for (auto const &i: *this) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fhash_set<T,Hash,Eq>::product() const
+    {
+        T product = 1;
+
+        for (auto const &i: *this) {
+            product *= i;
+        }
+        return product;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fhash_set<T,Hash,Eq>::min() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+        return *std::min_element(this->begin(),this->end());
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fhash_set<T,Hash,Eq>::max() const
+    {
+        if (this->empty()) throw "Cannot calculate the maximum of an empty set";
+        return *std::max_element(this->begin(),this->end());
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    std::tuple<T,T> fhash_set<T,Hash,Eq>::minmax() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+        auto mm = std::minmax_element(this->begin(),this->end());
+        return std::make_tuple(*mm.first,*mm.second);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::foreach(std::function<void(T)> action) const
+    {
+        for (auto const &i: *this) {
+            action(i);
+        }
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    template <typename U>
+    fhash_set<U> fhash_set<T,Hash,Eq>::select(std::function<U(T)> selector) const
+    {
+        fhash_set<U> res;
+        res.reserve(count);
+        for (auto const &i: *this) {
+            res.insert(selector(i));
+        }
+        return res;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fhash_set<T,Hash,Eq>::iterator::iterator(const fhash_set<T,Hash,Eq> *set, std::size_t index)
+        : set(set), index(index)
+    {
+        skip_free();
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator::reference
+    fhash_set<T,Hash,Eq>::iterator::operator*() const { return set->slots[index]; }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator::pointer
+    fhash_set<T,Hash,Eq>::iterator::operator->() const { return set->slots + index; }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator &fhash_set<T,Hash,Eq>::iterator::operator++()
+    {
+        ++index;
+        skip_free();
+        return *this;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fhash_set<T,Hash,Eq>::iterator fhash_set<T,Hash,Eq>::iterator::operator++(int)
+    {
+        iterator old(*this);
+        ++(*this);
+        return old;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fhash_set<T,Hash,Eq>::iterator::operator==(const iterator &other) const
+    {
+        return set == other.set && index == other.index;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fhash_set<T,Hash,Eq>::iterator::operator!=(const iterator &other) const
+    {
+        return !(*this == other);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::iterator::skip_free()
+    {
+        while (index < set->slot_count && set->ctrl[index] < 0) ++index;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::uint32_t fhash_set<T,Hash,Eq>::match_byte(const std::int8_t *group, std::int8_t b)
+    {
+#ifdef FNC_HASH_SET_SSE2
+        __m128i ctrl_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(b),ctrl_bytes)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < group_width; ++i) {
+            if (group[i] == b) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::uint32_t fhash_set<T,Hash,Eq>::match_free(const std::int8_t *group)
+    {
+        // empty and deleted are the only negative control bytes
+#ifdef FNC_HASH_SET_SSE2
+        __m128i ctrl_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_bytes));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < group_width; ++i) {
+            if (group[i] < 0) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline int fhash_set<T,Hash,Eq>::lowest_bit(std::uint32_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+#else
+        int i = 0;
+        while ((mask & 1u) == 0) {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    std::size_t fhash_set<T,Hash,Eq>::slots_for(std::size_t n)
+    {
+        // keep the load factor below 7/8
+        return n + n / 7 + 1;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::uint64_t fhash_set<T,Hash,Eq>::hash_of(const T &elem) const
+    {
+        // std::hash is the identity for integers: spread the bits so that
+        // both the group index and the 7-bit tag are well distributed.
+        return mix64(static_cast<std::uint64_t>(hasher(elem)));
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    std::size_t fhash_set<T,Hash,Eq>::find_index(const T &elem, std::uint64_t h) const
+    {
+        if (slot_count == 0) return slot_count;
+
+        std::size_t groups_mask = slot_count / group_width - 1;
+        std::size_t g = static_cast<std::size_t>(h >> 7) & groups_mask;
+        std::int8_t tag = static_cast<std::int8_t>(h & 0x7F);
+
+        // triangular probing visits every group once, since the number of
+        // groups is a power of two
+        for (std::size_t step = 1; step <= groups_mask + 1; ++step) {
+            const std::int8_t *group = ctrl + g * group_width;
+
+            for (std::uint32_t m = match_byte(group,tag); m != 0; m &= m - 1) {
+                std::size_t i = g * group_width + lowest_bit(m);
+                if (equal(slots[i],elem)) return i;
+            }
+            if (match_byte(group,empty_slot) != 0) break;
+
+            g = (g + step) & groups_mask;
+        }
+        return slot_count;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    std::size_t fhash_set<T,Hash,Eq>::find_free(std::uint64_t h) const
+    {
+        std::size_t groups_mask = slot_count / group_width - 1;
+        std::size_t g = static_cast<std::size_t>(h >> 7) & groups_mask;
+
+        for (std::size_t step = 1; ; ++step) {
+            std::uint32_t m = match_free(ctrl + g * group_width);
+            if (m != 0) return g * group_width + lowest_bit(m);
+
+            g = (g + step) & groups_mask;
+        }
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::allocate(std::size_t n)
+    {
+        ctrl = new std::int8_t[n];
+        std::memset(ctrl,empty_slot,n);
+        slots = std::allocator<T>().allocate(n);
+        slot_count = n;
+        growth_left = n - n / 8;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fhash_set<T,Hash,Eq>::release()
+    {
+        if (slot_count == 0) return;
+
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            if (ctrl[i] >= 0)
+                slots[i].~T();
+        }
+        delete [] ctrl;
+        std::allocator<T>().deallocate(slots,slot_count);
+        ctrl = nullptr;
+        slots = nullptr;
+        slot_count = count = growth_left = 0;
+    }
+}
@@ -0,0 +1,216 @@
+/*
+ *  collection/src/fhash_set.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fhash_set_h
+#define fhash_set_h
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+#include "algorithms.h"
+
+namespace fnc {
+
+    /*
+     * `fhash_set` is an unordered set stored in a flat open-addressing
+     * table, in the style of SwissTable.
+     *
+     * Every slot has a one-byte control word: it is either empty, deleted
+     * or holds the low 7 bits of the hash of the element stored in the
+     * slot. Control bytes are scanned 16 at a time (with SSE2 when it is
+     * available), so a lookup usually touches one group of control bytes
+     * and one slot, instead of walking a tree.
+     *
+     * The table keeps its load factor below 7/8 and doubles when full.
+     */
+    template <typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T> >
+    class fhash_set {
+
+    public :
+        class iterator;
+
+        fhash_set();
+
+        fhash_set(std::initializer_list<T> l);
+
+        fhash_set(const fhash_set<T,Hash,Eq> &other);
+
+        fhash_set(fhash_set<T,Hash,Eq> &&other);
+
+        ~fhash_set();
+
+        fhash_set<T,Hash,Eq> &operator=(fhash_set<T,Hash,Eq> other);
+
+        inline std::size_t size() const;
+
+        inline bool empty() const;
+
+        /*
+         * `capacity` returns the number of slots of the table.
+         */
+        inline std::size_t capacity() const;
+
+        iterator begin() const;
+
+        iterator end() const;
+
+        /*
+         * `insert` adds `elem` to the set and returns false if it was
+         * already there.
+         */
+        bool insert(T elem);
+
+        /*
+         * `erase` removes `elem` from the set and returns false if it was
+         * not there.
+         */
+        bool erase(T elem);
+
+        void clear();
+
+        /*
+         * `reserve` makes room for at least `n` elements, so that the next
+         * `n` insertions do not trigger a rehash.
+         */
+        void reserve(std::size_t n);
+
+        /*
+         * `rehash` rebuilds the table with at least `n` slots (and never
+         * fewer than the current size requires), dropping the tombstones
+         * left by `erase`.
+         */
+        void rehash(std::size_t n);
+
+        /*
+         * `copy` returns a copy of the fhash_set.
+         */
+        fhash_set<T,Hash,Eq> copy() const;
+
+        /*
+         * `map` applies to each element of the fhash_set the function
+         *
+         *    f: T --> T
+         *
+         * and then returns the fhash_set of mapped elements.
+         */
+        fhash_set<T,Hash,Eq> map(std::function<T(T)> f) const;
+
+        /*
+         * `filter` returns an fhash_set with the elements that fullfill
+         * the predicate function
+         *
+         *    f: T --> bool
+         */
+        fhash_set<T,Hash,Eq> filter(std::function<bool(T)> predicate) const;
+
+        fhash_set<T,Hash,Eq> unite(const fhash_set<T,Hash,Eq> &other) const;
+
+        fhash_set<T,Hash,Eq> intersecate(const fhash_set<T,Hash,Eq> &other) const;
+
+        fhash_set<T,Hash,Eq> except(const fhash_set<T,Hash,Eq> &other) const;
+
+        bool any(T elem) const;
+
+        fhash_set<T,Hash,Eq> singleton(T element) const;
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        T sum() const;
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        T product() const;
+
+        /*
+         * `min` returns the minimum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T min() const;
+
+        /*
+         * `max` returns the maximum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T max() const;
+
+        /*
+         * `minmax` returns the tuple <min,max>.
+         */
+        std::tuple<T,T> minmax() const;
+
+        void foreach(std::function<void(T)> action) const;
+
+        template <typename U> fhash_set<U> select(std::function<U(T)> selector) const;
+
+        class iterator {
+
+        public :
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T *pointer;
+            typedef const T &reference;
+
+            iterator(const fhash_set<T,Hash,Eq> *set, std::size_t index);
+
+            reference operator*() const;
+
+            pointer operator->() const;
+
+            iterator &operator++();
+
+            iterator operator++(int);
+
+            bool operator==(const iterator &other) const;
+
+            bool operator!=(const iterator &other) const;
+
+        private :
+            const fhash_set<T,Hash,Eq> *set;
+            std::size_t index;
+
+            void skip_free();
+        };
+
+    private :
+        static const std::int8_t empty_slot = -128;
+        static const std::int8_t deleted_slot = -2;
+        static const std::size_t group_width = 16;
+
+        std::int8_t *ctrl;
+        T *slots;
+        std::size_t slot_count;
+        std::size_t count;
+        std::size_t growth_left;
+        Hash hasher;
+        Eq equal;
+
+        static inline std::uint32_t match_byte(const std::int8_t *group, std::int8_t b);
+        static inline std::uint32_t match_free(const std::int8_t *group);
+        static inline int lowest_bit(std::uint32_t mask);
+        static std::size_t slots_for(std::size_t n);
+
+        inline std::uint64_t hash_of(const T &elem) const;
+        std::size_t find_index(const T &elem, std::uint64_t h) const;
+        std::size_t find_free(std::uint64_t h) const;
+        void allocate(std::size_t n);
+        void release();
+    };
+
+}
+
+#include "fhash_set.cc"
+
+#endif
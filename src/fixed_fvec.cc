@@ -0,0 +1,243 @@
+/*
+ *  collection/src/fixed_fvec.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+namespace fnc {
+
+    template <typename T, std::size_t N>
+    constexpr fixed_fvec<T,N>::fixed_fvec() : elems{}, count(0) {}
+
+    template <typename T, std::size_t N>
+    constexpr fixed_fvec<T,N>::fixed_fvec(std::initializer_list<T> init) : elems{}, count(0)
+    {
+        if (init.size() > N) throw "Too many elements for the capacity of the fixed_fvec";
+
+        for (auto const &i: init) {
+            elems[count++] = i;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    constexpr std::size_t fixed_fvec<T,N>::size() const { return count; }
+
+    template <typename T, std::size_t N>
+    constexpr std::size_t fixed_fvec<T,N>::capacity() const { return N; }
+
+    template <typename T, std::size_t N>
+    constexpr bool fixed_fvec<T,N>::empty() const { return count == 0; }
+
+    template <typename T, std::size_t N>
+    constexpr T &fixed_fvec<T,N>::operator[](std::size_t i) { return elems[i]; }
+
+    template <typename T, std::size_t N>
+    constexpr const T &fixed_fvec<T,N>::operator[](std::size_t i) const { return elems[i]; }
+
+    template <typename T, std::size_t N>
+    constexpr typename fixed_fvec<T,N>::iterator fixed_fvec<T,N>::begin() { return elems; }
+
+    template <typename T, std::size_t N>
+    constexpr typename fixed_fvec<T,N>::iterator fixed_fvec<T,N>::end() { return elems + count; }
+
+    template <typename T, std::size_t N>
+    constexpr typename fixed_fvec<T,N>::const_iterator fixed_fvec<T,N>::begin() const { return elems; }
+
+    template <typename T, std::size_t N>
+    constexpr typename fixed_fvec<T,N>::const_iterator fixed_fvec<T,N>::end() const { return elems + count; }
+
+    template <typename T, std::size_t N>
+    constexpr T fixed_fvec<T,N>::head() const
+    {
+        if (count == 0) throw "ERROR: empty vector";
+        return elems[0];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr T fixed_fvec<T,N>::last() const
+    {
+        if (count == 0) throw "ERROR: empty vector";
+        return elems[count-1];
+    }
+
+    template <typename T, std::size_t N>
+    constexpr void fixed_fvec<T,N>::push_back(const T &elem)
+    {
+        if (count == N) throw "The fixed_fvec is full";
+        elems[count++] = elem;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename F>
+    constexpr fixed_fvec<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type,N>
+    fixed_fvec<T,N>::map(F f) const
+    {
+        fixed_fvec<typename std::decay<decltype(f(std::declval<const T &>()))>::type,N> res;
+        for (std::size_t i = 0; i < count; ++i) {
+            res.push_back(f(elems[i]));
+        }
+        return res;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename P>
+    constexpr fixed_fvec<T,N> fixed_fvec<T,N>::filter(P predicate) const
+    {
+        fixed_fvec<T,N> res;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (predicate(elems[i])) res.push_back(elems[i]);
+        }
+        return res;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename F, typename U>
+    constexpr U fixed_fvec<T,N>::foldl(F f, U base) const
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            base = f(base,elems[i]);
+        }
+        return base;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename F, typename U>
+    constexpr U fixed_fvec<T,N>::foldr(F f, U base) const
+    {
+        for (std::size_t i = count; i > 0; --i) {
+            base = f(elems[i-1],base);
+        }
+        return base;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr T fixed_fvec<T,N>::sum() const
+    {
+        T acc = T(0);
+        for (std::size_t i = 0; i < count; ++i) {
+            acc = acc + elems[i];
+        }
+        return acc;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr T fixed_fvec<T,N>::product() const
+    {
+        T acc = T(1);
+        for (std::size_t i = 0; i < count; ++i) {
+            acc = acc * elems[i];
+        }
+        return acc;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr bool fixed_fvec<T,N>::any(const T &elem) const
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (elems[i] == elem) return true;
+        }
+        return false;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr fixed_fvec<T,N> fixed_fvec<T,N>::sort() const
+    {
+        fixed_fvec<T,N> sorted(*this);
+        for (std::size_t i = 1; i < sorted.count; ++i) {
+            T x = sorted.elems[i];
+            std::size_t j = i;
+            for (; j > 0 && x < sorted.elems[j-1]; --j) {
+                sorted.elems[j] = sorted.elems[j-1];
+            }
+            sorted.elems[j] = x;
+        }
+        return sorted;
+    }
+
+    template <typename T, std::size_t N>
+    template <typename Cmp>
+    constexpr fixed_fvec<T,N> fixed_fvec<T,N>::sort(Cmp comparator) const
+    {
+        fixed_fvec<T,N> sorted(*this);
+        for (std::size_t i = 1; i < sorted.count; ++i) {
+            T x = sorted.elems[i];
+            std::size_t j = i;
+            for (; j > 0 && comparator(x,sorted.elems[j-1]); --j) {
+                sorted.elems[j] = sorted.elems[j-1];
+            }
+            sorted.elems[j] = x;
+        }
+        return sorted;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr fixed_fvec<T,N> fixed_fvec<T,N>::distinct() const
+    {
+        fixed_fvec<T,N> res;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!res.any(elems[i])) res.push_back(elems[i]);
+        }
+        return res;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr fixed_fvec<T,N> fixed_fvec<T,N>::reverse() const
+    {
+        fixed_fvec<T,N> res;
+        for (std::size_t i = count; i > 0; --i) {
+            res.push_back(elems[i-1]);
+        }
+        return res;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr std::array<T,N> fixed_fvec<T,N>::to_array() const
+    {
+        return this->to_array(std::make_index_sequence<N>());
+    }
+
+    template <typename T, std::size_t N>
+    template <std::size_t... I>
+    constexpr std::array<T,N> fixed_fvec<T,N>::to_array(std::index_sequence<I...>) const
+    {
+        return std::array<T,N>{{ (I < count ? elems[I] : T())... }};
+    }
+
+    template <typename T, std::size_t N>
+    fvec<T> fixed_fvec<T,N>::to_fvec() const
+    {
+        fvec<T> vec;
+        append_range(vec,this->begin(),this->end());
+        return vec;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr bool operator==(const fixed_fvec<T,N> &a, const fixed_fvec<T,N> &b)
+    {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (!(a[i] == b[i])) return false;
+        }
+        return true;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr bool operator!=(const fixed_fvec<T,N> &a, const fixed_fvec<T,N> &b)
+    {
+        return !(a == b);
+    }
+
+    template <int start, int stop, int step>
+    constexpr fixed_fvec<int,fixed_vrange_size(start,stop,step)> fixed_vrange()
+    {
+        fixed_fvec<int,fixed_vrange_size(start,stop,step)> range;
+        if (start <= stop) {
+            for (int i = start; i < stop; i += step) range.push_back(i);
+        } else {
+            for (int i = start; i > stop; i -= step) range.push_back(i);
+        }
+        return range;
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ *  collection/src/fixed_fvec.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fixed_fvec_h
+#define fixed_fvec_h
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+#include "fvec.h"
+
+namespace fnc {
+
+    /*
+     * `fixed_fvec` is an fvec of at most N elements stored inline, with
+     * no heap allocation, whose functional API is constexpr: tables can
+     * be computed at compile time and stored in read-only data, with no
+     * work at startup.
+     *
+     * Example:
+     *
+     *     struct square {
+     *         constexpr int operator()(int x) const { return x * x; }
+     *     };
+     *
+     *     constexpr auto squares = fixed_vrange<0,256>().map(square());
+     *     static_assert(squares[12] == 144, "");
+     *
+     * The operations that can shrink the fvec (filter, distinct) keep the
+     * capacity N and return fewer elements.
+     *
+     * WARNING: in C++14 lambdas cannot be called in constant expressions:
+     * to evaluate at compile time, pass function objects with a constexpr
+     * operator(), or pointers to constexpr functions. T must be a literal
+     * type with a default constructor. The storage is a plain array rather
+     * than a std::array, whose elements cannot be assigned in constant
+     * expressions before C++17; `to_array` returns one.
+     */
+    template <typename T, std::size_t N>
+    class fixed_fvec {
+
+    public :
+        typedef T value_type;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+        constexpr fixed_fvec();
+
+        constexpr fixed_fvec(std::initializer_list<T> init);
+
+        constexpr std::size_t size() const;
+
+        constexpr std::size_t capacity() const;
+
+        constexpr bool empty() const;
+
+        constexpr T &operator[](std::size_t i);
+
+        constexpr const T &operator[](std::size_t i) const;
+
+        constexpr iterator begin();
+
+        constexpr iterator end();
+
+        constexpr const_iterator begin() const;
+
+        constexpr const_iterator end() const;
+
+        constexpr T head() const;
+
+        constexpr T last() const;
+
+        /*
+         * `push_back` appends `elem`.
+         * WARNING: the fvec must not be full.
+         */
+        constexpr void push_back(const T &elem);
+
+        template <typename F>
+        constexpr fixed_fvec<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type,N>
+        map(F f) const;
+
+        template <typename P>
+        constexpr fixed_fvec<T,N> filter(P predicate) const;
+
+        /*
+         * `foldl` and `foldr` reduce the fvec as the ones of fvec:
+         *
+         *     foldl(f,base) = f(f(f(base,x1),x2),x3)
+         *     foldr(f,base) = f(x1,f(x2,f(x3,base)))
+         */
+        template <typename F, typename U>
+        constexpr U foldl(F f, U base) const;
+
+        template <typename F, typename U>
+        constexpr U foldr(F f, U base) const;
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        constexpr T sum() const;
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        constexpr T product() const;
+
+        constexpr bool any(const T &elem) const;
+
+        /*
+         * `sort` returns the elements sorted by (<), or by `comparator`,
+         * stably. It is an insertion sort, meant for small tables.
+         */
+        constexpr fixed_fvec<T,N> sort() const;
+
+        template <typename Cmp>
+        constexpr fixed_fvec<T,N> sort(Cmp comparator) const;
+
+        /*
+         * `distinct` keeps the first occurrence of each element.
+         * WARNING: T must implement the operator (==)
+         */
+        constexpr fixed_fvec<T,N> distinct() const;
+
+        constexpr fixed_fvec<T,N> reverse() const;
+
+        constexpr std::array<T,N> to_array() const;
+
+        fvec<T> to_fvec() const;
+
+    private :
+        T elems[N > 0 ? N : 1];
+        std::size_t count;
+
+        template <std::size_t... I>
+        constexpr std::array<T,N> to_array(std::index_sequence<I...>) const;
+    };
+
+    template <typename T, std::size_t N>
+    constexpr bool operator==(const fixed_fvec<T,N> &a, const fixed_fvec<T,N> &b);
+
+    template <typename T, std::size_t N>
+    constexpr bool operator!=(const fixed_fvec<T,N> &a, const fixed_fvec<T,N> &b);
+
+    /*
+     * `fixed_vrange_size` is the number of elements of vrange(start,stop,step).
+     */
+    constexpr std::size_t fixed_vrange_size(int start, int stop, int step)
+    {
+        return start <= stop ? static_cast<std::size_t>((stop - start + step - 1) / step)
+                             : static_cast<std::size_t>((start - stop + step - 1) / step);
+    }
+
+    /*
+     * `fixed_vrange` is the constexpr `vrange`: the integers from start
+     * to stop (excluded) by step, counting down if start > stop.
+     */
+    template <int start, int stop, int step = 1>
+    constexpr fixed_fvec<int,fixed_vrange_size(start,stop,step)> fixed_vrange();
+
+}
+
+#include "fixed_fvec.cc"
+
+#endif
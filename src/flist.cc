@@ -11,7 +11,10 @@
 #include <map>
 #include <tuple>
 #include <random>
-#include <chrono>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
 
 namespace fnc {
 
@@ -32,13 +35,13 @@ namespace fnc {
 
     inline flist<int> lrange(int stop, int step = 1) { return lrange(0,stop,step); }
 
-    template <typename T>
-    flist<T> cycle(flist<T> list, int n)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> cycle(flist<T,Backend> list, int n)
     {
         if (list.empty()) throw "ERROR: empty vector";
         if (n < 0) throw "n must be greater (or equal) than 0";
         
-        flist<T> new_list;
+        flist<T,Backend> new_list;
         for (int i = 0; i < n; ++i) {
             for (auto const &i: list) {
                 new_list.push_back(i);
@@ -48,114 +51,204 @@ namespace fnc {
         return new_list;
     }
 
-    template <typename T>
-    flist<T>::flist() : std::list<T>() {}
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend>::flist() : Backend<T>() {}
 
-    template <typename T>
-    flist<T>::flist(std::list<T> l) : std::list<T>(l) {}
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend>::flist(std::list<T> l) : Backend<T>(l.begin(),l.end()) {}
 
-    template <typename T>
-    inline std::list<T> flist<T>::to_list() { return *this; }
+    template <typename T, template <typename...> class Backend>
+    inline std::list<T> flist<T,Backend>::to_list()
+    {
+        return std::list<T>(this->begin(),this->end());
+    }
 
-    template <typename T>
-    inline T flist<T>::head() { return this->front(); }
+    template <typename T, template <typename...> class Backend>
+    inline T flist<T,Backend>::head() { return this->front(); }
 
-    template <typename T>
-    flist<T> flist<T>::drop(int n)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::drop(int n) &
     {
-        flist<T> list;
-        
-        if (this->empty()) return list;
-        
-        for (auto first = this->begin()+n; first != this->end(); ++first) {
+        flist<T,Backend> list;
+        for (auto first = this->position(n); first != this->end(); ++first) {
             list.push_back(*first);
         }
         return list;
     }
 
-    template <typename T>
-    flist<T> flist<T>::tail() { return this->drop(1); }
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::drop(int n) &&
+    {
+        this->erase(this->begin(),this->position(n));
+        return std::move(*this);
+    }
 
-    template <typename T>
-    flist<T> flist<T>::init()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::tail() { return this->drop(1); }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::init()
     {
-        flist<T> new_list(*this);
+        flist<T,Backend> new_list(*this);
         new_list.pop_back();
         return new_list;
     }
 
-    template <typename T>
-    inline T flist<T>::last()
+    template <typename T, template <typename...> class Backend>
+    inline T flist<T,Backend>::last()
     {
-        return *(this->end()-1);
+        return this->back();
     }
 
-    template <typename T>
-    flist<T> flist<T>::take(int n)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::take(int n) &
     {
-        flist<T> new_list;
-        int counter = 0;
+        flist<T,Backend> list;
+        for (auto first = this->begin(), last = this->position(n); first != last; ++first) {
+            list.push_back(*first);
+        }
+        return list;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::take(int n) &&
+    {
+        this->erase(this->position(n),this->end());
+        return std::move(*this);
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::take_while(std::function<bool(T)> predicate) &
+    {
+        flist<T,Backend> new_list;
         for (auto const &i: *this) {
-            if (counter == n) break;
+            if (!predicate(i)) break;
             new_list.push_back(i);
-            counter++;
         }
         return new_list;
     }
 
-    template <typename T>
-    flist<T> flist<T>::copy()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::take_while(std::function<bool(T)> predicate) &&
     {
-        flist<T> new_list;
-        for (auto const &i: *this) {
-            new_list.push_back(i);
+        auto cut = std::find_if_not(this->begin(),this->end(),predicate);
+        this->erase(cut,this->end());
+        return std::move(*this);
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::drop_while(std::function<bool(T)> predicate) &
+    {
+        flist<T,Backend> new_list;
+        auto cut = std::find_if_not(this->begin(),this->end(),predicate);
+        for (; cut != this->end(); ++cut) {
+            new_list.push_back(*cut);
         }
         return new_list;
     }
 
-    template <typename T>
-    T flist<T>::foldr(std::function<T(T,T)> f, T base)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::drop_while(std::function<bool(T)> predicate) &&
     {
-        if (this->empty()) return base;
-        return f(this->head(),this->tail().foldr(f,base));
+        auto cut = std::find_if_not(this->begin(),this->end(),predicate);
+        this->erase(this->begin(),cut);
+        return std::move(*this);
+    }
+
+    template <typename T, template <typename...> class Backend>
+    std::tuple<flist<T,Backend>,flist<T,Backend>> flist<T,Backend>::split_at(int n) &
+    {
+        return std::make_tuple(this->take(n),this->drop(n));
+    }
+
+    template <typename T, template <typename...> class Backend>
+    std::tuple<flist<T,Backend>,flist<T,Backend>> flist<T,Backend>::split_at(int n) &&
+    {
+        flist<T,Backend> first;
+        list_relink(static_cast<backend &>(first),static_cast<backend &>(*this),this->begin(),this->position(n));
+        return std::make_tuple(std::move(first),std::move(*this));
+    }
+
+    template <typename T, template <typename...> class Backend>
+    std::tuple<flist<T,Backend>,flist<T,Backend>>
+    flist<T,Backend>::partition(std::function<bool(T)> predicate) &
+    {
+        flist<T,Backend> accepted;
+        flist<T,Backend> rejected;
+        for (auto const &i: *this) {
+            if (predicate(i))
+                accepted.push_back(i);
+            else
+                rejected.push_back(i);
+        }
+        return std::make_tuple(std::move(accepted),std::move(rejected));
+    }
+
+    template <typename T, template <typename...> class Backend>
+    std::tuple<flist<T,Backend>,flist<T,Backend>>
+    flist<T,Backend>::partition(std::function<bool(T)> predicate) &&
+    {
+        flist<T,Backend> rejected;
+        list_partition(static_cast<backend &>(*this),static_cast<backend &>(rejected),predicate);
+        return std::make_tuple(std::move(*this),std::move(rejected));
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::copy()
+    {
+        flist<T,Backend> new_list;
+        append_all(new_list,*this);
+        return new_list;
     }
 
-    template <typename T>
-    T flist<T>::foldl(std::function<T(T,T)> f, T base)
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::foldr(std::function<T(T,T)> f, T base)
     {
-        if (this->empty()) return base;
-        return this->tail().foldl(f,f(base,this->head()));
+        T acc = base;
+        for (auto i = this->end(); i != this->begin(); ) {
+            --i;
+            acc = f(*i,acc);
+        }
+        return acc;
     }
 
-    template <typename T>
-    flist<T> flist<T>::scanr(std::function<T(T,T)> f, T base)
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::foldl(std::function<T(T,T)> f, T base)
     {
-        flist<T> list;
-        auto tails = this->tails();
-        for (flist<T> &i: tails) {
-            list.push_back(i.foldr(f,base));
+        T acc = base;
+        for (auto const &i: *this) {
+            acc = f(acc,i);
         }
+        return acc;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::scanr(std::function<T(T,T)> f, T base)
+    {
+        flist<T,Backend> list;
         list.push_back(base);
-        
+        for (auto i = this->end(); i != this->begin(); ) {
+            --i;
+            list.push_front(f(*i,list.front()));
+        }
         return list;
     }
 
-    template <typename T>
-    flist<T> flist<T>::scanl(std::function<T(T,T)> f, T base)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::scanl(std::function<T(T,T)> f, T base)
     {
-        flist<T> list({base});
-        auto inits = this->inits();
-        for (flist<T> &i: inits) {
-            list.push_back(i.foldl(f,base));
+        flist<T,Backend> list;
+        list.push_back(base);
+        for (auto const &i: *this) {
+            list.push_back(f(list.back(),i));
         }
-        
         return list;
     }
 
-    template <typename T>
-    flist<flist<T> > flist<T>::group()
+    template <typename T, template <typename...> class Backend>
+    flist<flist<T,Backend>,Backend> flist<T,Backend>::group()
     {
-        flist<flist<T> > grouped;
+        flist<flist<T,Backend>,Backend> grouped;
         std::map<T,int> m;
         for (auto const &e : *this) {
             if (map_contains(m,e)) 
@@ -165,7 +258,7 @@ namespace fnc {
         }
 
         for (auto const& x : m) {
-            flist<T> group;
+            flist<T,Backend> group;
             for (int i = 0; i < x.second; i++) {
                 group.push_back(x.first);
             }
@@ -174,14 +267,14 @@ namespace fnc {
         return grouped;
     }
 
-    template <typename T>
-    flist<flist<T> > flist<T>::clusterize_by(std::function<bool(T,T)> f)
+    template <typename T, template <typename...> class Backend>
+    flist<flist<T,Backend>,Backend> flist<T,Backend>::clusterize_by(std::function<bool(T,T)> f)
     {
-        flist<flist<T> > clusterized;
+        flist<flist<T,Backend>,Backend> clusterized;
         auto i = this->begin();
         
         while(i != this->end()) {
-            flist<T> tmp;
+            flist<T,Backend> tmp;
             tmp.push_back(*i);
             while (f(*i,*(i+1))) {
                 tmp.push_back(*i);
@@ -194,78 +287,67 @@ namespace fnc {
         return clusterized;
     }
     
-    template <typename T>
-    flist<flist<T> > flist<T>::clusterize()
+    template <typename T, template <typename...> class Backend>
+    flist<flist<T,Backend>,Backend> flist<T,Backend>::clusterize()
     {
         return this->clusterize_by([](T x, T y) { return x == y; });
     }
 
-    template <typename T>
-    flist<T> flist<T>::map(std::function<T(T)> f)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::map(std::function<T(T)> f)
     {
-        flist<T> list;
-        for (auto const &i: *this) {
-                list.push_back(f(i));
-        }
+        flist<T,Backend> list;
+        map_into(list,*this,f);
         return list;
     }
 
-    template <typename T>
-    flist<T> flist<T>::filter(std::function<bool(T)> predicate)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::filter(std::function<bool(T)> predicate)
     {
-        flist<T> list;
-        for (auto const &i: *this) {
-            if (predicate(i))
-                list.push_back(i);
-        }
+        flist<T,Backend> list;
+        filter_into(list,*this,predicate);
         return list;
     }
 
-    template <typename T>
-    flist<flist<T> > flist<T>::zip(flist<T> other)
+    template <typename T, template <typename...> class Backend>
+    template <typename U>
+    flist<std::tuple<T,U>,Backend> flist<T,Backend>::zip(const flist<U,Backend> &other)
     {
-        flist<flist<T> > result;
-        
-        for (auto first = this->begin(), second = other.begin();
-            first != this->end() && second != other.end();
-            ++first,++second) {
-            flist<T> tmp;
-            tmp.push_back(*first);
-            tmp.push_back(*second);
-            result.push_back(tmp);
-        }
-        return result;                    
+        return this->zip_with(other,[](const T &x, const U &y) { return std::make_tuple(x,y); });
     }
 
-    template <typename T>
-    flist<T> flist<T>::zip_with(flist<T> other, std::function<bool(T,T)> f)
+    template <typename T, template <typename...> class Backend>
+    template <typename U, typename F>
+    flist<typename std::decay<decltype(std::declval<F &>()(std::declval<T &>(),
+                                                           std::declval<const U &>()))>::type,Backend>
+    flist<T,Backend>::zip_with(const flist<U,Backend> &other, F f)
     {
-        flist<T> result;
-        
-        for (auto first = this->begin(), second = other.begin();
-            first != this->end() && second != other.end();
-            ++first,++second) {
-            result.push_back(f(*first,*second));
+        flist<typename std::decay<decltype(f(std::declval<T &>(),std::declval<const U &>()))>::type,Backend> result;
+        for (auto const &t: fnc::zip(*this,other)) {
+            result.push_back(f(std::get<0>(t),std::get<1>(t)));
         }
-        
         return result;
     }
 
-    template <typename T>
-    flist<T> flist<T>::concat(flist<T> other)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::concat(flist<T,Backend> other) &
     {
-        flist<T> list(*this);
-        for (auto const &i: other) {
-            list.push_back(i);
-        }
-        
+        flist<T,Backend> list(*this);
+        list_relink(static_cast<backend &>(list),static_cast<backend &>(other),other.begin(),other.end());
         return list;
     }
 
-    template <typename T>
-    flist<flist<T> > flist<T>::inits()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::concat(flist<T,Backend> other) &&
+    {
+        list_relink(static_cast<backend &>(*this),static_cast<backend &>(other),other.begin(),other.end());
+        return std::move(*this);
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<flist<T,Backend>,Backend> flist<T,Backend>::inits()
     {
-        flist<flist<T> > new_list;
+        flist<flist<T,Backend>,Backend> new_list;
         
         if (this->empty()) return new_list;
         
@@ -274,10 +356,10 @@ namespace fnc {
     }
 
 
-    template <typename T>
-    flist<flist<T> > flist<T>::tails()
+    template <typename T, template <typename...> class Backend>
+    flist<flist<T,Backend>,Backend> flist<T,Backend>::tails()
     {
-        flist<flist<T> > new_list;
+        flist<flist<T,Backend>,Backend> new_list;
         
         if (this->empty()) return new_list;
         
@@ -285,11 +367,11 @@ namespace fnc {
         return new_list.concat(this->tail().tails());
     }
 
-    template <typename T>
-    flist<T> flist<T>::unite(flist<T> other)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::unite(flist<T,Backend> other)
     {
         std::map<T,bool> m;
-        flist<T> united;
+        flist<T,Backend> united;
         for (auto const &i: *this) {
             united.push_back(i);
             if (! map_contains(m,i)) m[i] = true;
@@ -301,11 +383,11 @@ namespace fnc {
         return united;
     }
 
-    template <typename T>
-    flist<T> flist<T>::intersecate(flist<T> other)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::intersecate(flist<T,Backend> other)
     {
         std::map<T,bool> m;
-        flist<T> intersected;
+        flist<T,Backend> intersected;
         for (auto const &i: *this) {
             if (! map_contains(m,i)) m[i] = true;
         }
@@ -316,11 +398,24 @@ namespace fnc {
         return intersected;
     }
 
-    template <typename T>
-    flist<T> flist<T>::distinct()
+    template <typename T, template <typename...> class Backend>
+    template <typename S, typename H>
+    flist<T,Backend> flist<T,Backend>::intersecate(const S &other, const bloom<T,H> &filter)
+    {
+        flist<T,Backend> intersected;
+        for (auto const &i: *this) {
+            if (filter.possibly_contains(i) && other.find(i) != other.end())
+                intersected.push_back(i);
+        }
+
+        return intersected;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::distinct()
     {
         std::map<T,bool> m;
-        flist<T> new_list;
+        flist<T,Backend> new_list;
         for (auto const &i: *this) {
             if (!map_containsKey(m,i)) {
                 m[i] = true;
@@ -330,88 +425,86 @@ namespace fnc {
         return new_list;
     }
 
-    template <typename T>
-    inline bool flist<T>::any(T elem) { return this->find(elem) != this->end(); }
+    template <typename T, template <typename...> class Backend>
+    inline bool flist<T,Backend>::any(T elem)
+    {
+        return std::find(this->begin(),this->end(),elem) != this->end();
+    }
+
+    template <typename T, template <typename...> class Backend>
+    template <typename H>
+    inline bool flist<T,Backend>::any(T elem, const bloom<T,H> &filter)
+    {
+        return filter.possibly_contains(elem) && this->any(elem);
+    }
 
-    template <typename T>
-    inline flist<T> flist<T>::singleton(T element) { return flist<T>({element}); }
+    template <typename T, template <typename...> class Backend>
+    inline flist<T,Backend> flist<T,Backend>::singleton(T element) { return flist<T,Backend>({element}); }
 
-    template <typename T>
-    flist<T> flist<T>::reverse()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::reverse()
     {
-        std::list<T> new_list(*this);
-        new_list.reverse();
+        flist<T,Backend> new_list(*this);
+        static_cast<backend &>(new_list).reverse();
         return new_list;
     }
 
-    template <typename T>
-    T flist<T>::sum()
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::sum()
     {
-        T sum = 0;
-
-        for (auto const &i: *this) {
-            sum += i;
-        }
-        return sum;
+        return accumulate_sum(*this,T(0));
     }
 
-    template <typename T>
-    T flist<T>::product()
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::product()
     {
-        T product = 1;
-
-        for (auto const &i: *this) {
-            product *= i;
-        }
-        return product;
+        return accumulate_product(*this,T(1));
     }
 
-    template <typename T>
-    T flist<T>::min()
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::min()
     {
         //if (this->size() == 0)
         if (this->size() == 1) return this->head();
         return std::min(this->head(),this->tail().min());
     }
 
-    template <typename T>
-    T flist<T>::max()
+    template <typename T, template <typename...> class Backend>
+    T flist<T,Backend>::max()
     {
         //if (this->size() == 0)
         if (this->size() == 1) return this->head();
         return std::max(this->head(),this->tail().max());
     }
 
-    template <typename T>
-    std::tuple<T,T> flist<T>::minmax()
+    template <typename T, template <typename...> class Backend>
+    std::tuple<T,T> flist<T,Backend>::minmax()
     {
         return std::make_tuple(this->min(),this->max);
     }
 
-    template <typename T>
-    void flist<T>::foreach(std::function<void(T)> action)
+    template <typename T, template <typename...> class Backend>
+    void flist<T,Backend>::foreach(std::function<void(T)> action)
     {
         for (auto const &i: *this) {
             action(i);
         }
     }
 
-    template <typename T>
+    template <typename T, template <typename...> class Backend>
     template <typename U>
-    flist<U> flist<T>::select(std::function<U(T)> selector)
+    flist<U,Backend> flist<T,Backend>::select(std::function<U(T)> selector)
     {
-        flist<U> res;
-        for (auto const &i: *this) {
-            res.push_back(selector(i));
-        }
+        flist<U,Backend> res;
+        map_into(res,*this,selector);
         return res;
     }
 
-    template <typename T>
-    flist<T> flist<T>::except(flist<T> other)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::except(flist<T,Backend> other)
     {
         std::map<T,bool> m;
-        flist<T> res;
+        flist<T,Backend> res;
         for (auto const &i: other) {
             if (! map_contains(m,i)) m[i] = true;
         }
@@ -422,38 +515,63 @@ namespace fnc {
         return res;
     }
 
-    template <typename T>
-    flist<T> flist<T>::sort(std::function<bool(T,T)> comparator)
+    template <typename T, template <typename...> class Backend>
+    template <typename S, typename H>
+    flist<T,Backend> flist<T,Backend>::except(const S &other, const bloom<T,H> &filter)
     {
-        std::list<T> sorted(*this);
-        sorted.sort(comparator);
+        flist<T,Backend> res;
+        for (auto const &i: *this) {
+            if (!filter.possibly_contains(i) || other.find(i) == other.end())
+                res.push_back(i);
+        }
+
+        return res;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::sort(std::function<bool(T,T)> comparator)
+    {
+        flist<T,Backend> sorted(*this);
+        list_sort(static_cast<backend &>(sorted),comparator);
         return sorted;
     }
 
-    template <typename T>
-    flist<T> flist<T>::sort()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::sort()
     {
-        return this->sort([](T x,T y) { return x <= y; });
+        return this->sort([](T x,T y) { return x < y; });
     }
 
-    template <typename T>
-    flist<T> flist<T>::sort_heap(std::function<bool(T,T)> comparator)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::sort_heap(std::function<bool(T,T)> comparator)
     {
-        flist<T> sorted(*this);
-        std::sort_heap(sorted.begin(),sorted.end(),comparator);
-        return sorted;
+        return this->sort(comparator);
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::sort_heap()
+    {
+        return this->sort();
     }
 
-    template <typename T>
-    flist<T> flist<T>::sort_heap()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::merge(flist<T,Backend> other, std::function<bool(T,T)> comparator)
     {
-        return this->sort_heap([](T x,T y) { return x <= y; });
+        flist<T,Backend> merged(*this);
+        list_merge(static_cast<backend &>(merged),static_cast<backend &>(other),comparator);
+        return merged;
     }
 
-    template <typename T>
-    flist<T> flist<T>::intersperse(T elem)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::merge(flist<T,Backend> other)
     {
-        flist<T> new_vector;
+        return this->merge(other,[](T x,T y) { return x < y; });
+    }
+
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::intersperse(T elem)
+    {
+        flist<T,Backend> new_vector;
         
         for (auto start = this->begin(), last = this->end()-1;
             start != this->end(); ++start) {
@@ -467,32 +585,204 @@ namespace fnc {
         return new_vector;
     }
 
-    template <typename T>
-    flist<T> flist<T>::rotate_left(int n_positions)
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::rotate_left(int n_positions) &
     {
-        std::list<T> new_list(*this);
-        std::rotate(new_list.begin(),new_list.begin()+n_positions,new_list.end());
-
-        return new_list;
+        return flist<T,Backend>(*this).rotate_left(n_positions);
     }
 
-    template <typename T>
-    flist<T> flist<T>::shuffle()
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::rotate_left(int n_positions) &&
     {
-        flist<T> new_list(*this);
+        int size = static_cast<int>(this->size());
+        if (size == 0) return std::move(*this);
 
-        auto seed = std::chrono::system_clock::now().time_since_epoch().count();
+        int n = (n_positions % size + size) % size;
+        this->splice(this->end(),*this,this->begin(),this->position(n));
+        return std::move(*this);
+    }
 
-        shuffle (new_list.begin(), new_list.end(), std::default_random_engine(seed));
-        
-        return new_list;
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::shuffle()
+    {
+        std::vector<T> elems(this->begin(),this->end());
+        shuffle_range(elems.begin(),elems.end(),thread_rng());
+        flist<T,Backend> list;
+        append_range(list,elems.begin(),elems.end());
+        return list;
     }
 
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> flist<T,Backend>::shuffle(std::uint64_t seed)
+    {
+        std::vector<T> elems(this->begin(),this->end());
+        xoshiro256 rng(seed);
+        shuffle_range(elems.begin(),elems.end(),rng);
+        flist<T,Backend> list;
+        append_range(list,elems.begin(),elems.end());
+        return list;
+    }
 
-    template <typename T>
+
+    template <typename T, template <typename...> class Backend>
     template <typename U>
-    inline bool flist<T>::map_contains(std::map<T,U> m, T val)
+    inline bool flist<T,Backend>::map_contains(const std::map<T,U> &m, T val)
     {
         return m.find(val) != m.end();
     }
+
+    template <typename T, template <typename...> class Backend>
+    typename flist<T,Backend>::backend::iterator flist<T,Backend>::position(int n)
+    {
+        auto it = this->begin();
+        if (n <= 0) return it;
+        if (static_cast<std::size_t>(n) >= this->size()) return this->end();
+
+        std::advance(it,n);
+        return it;
+    }
+
+    /*
+     * `sequential_list_sort` keeps in bins[i] a sorted run of 2^i nodes:
+     * every node is merged into the bins like a carry in a binary counter,
+     * then the bins are merged together. The runs in the higher bins come
+     * from earlier in the list, so merging them first keeps the sort stable.
+     */
+    template <typename T, typename A, typename Compare>
+    void sequential_list_sort(std::list<T,A> &l, Compare &comp)
+    {
+        if (l.size() < 2) return;
+
+        std::list<T,A> carry(l.get_allocator());
+        std::vector<std::list<T,A>> bins;
+
+        while (!l.empty()) {
+            carry.splice(carry.begin(),l,l.begin());
+
+            std::size_t i = 0;
+            for (; i < bins.size() && !bins[i].empty(); ++i) {
+                bins[i].merge(carry,std::ref(comp));
+                carry.swap(bins[i]);
+            }
+            if (i == bins.size())
+                bins.emplace_back(l.get_allocator());
+            carry.swap(bins[i]);
+        }
+
+        for (std::size_t i = 1; i < bins.size(); ++i) {
+            bins[i].merge(bins[i-1],std::ref(comp));
+        }
+        l.swap(bins.back());
+    }
+
+    template <typename T, typename A, typename Compare>
+    void list_sort(std::list<T,A> &l, Compare comp)
+    {
+        std::size_t n = l.size();
+        std::size_t parts = std::min<std::size_t>(scheduler::instance().concurrency(),
+                                                  n / FNC_PARALLEL_SORT_THRESHOLD);
+        if (parts < 2) {
+            sequential_list_sort(l,comp);
+            return;
+        }
+
+        // cut the list in `parts` runs, moving the nodes
+        // each run is built from the allocator of `l`, not copied from a
+        // prototype: a copy may select another allocator, and the splices
+        // below need them equal
+        std::vector<std::list<T,A>> runs;
+        runs.reserve(parts);
+        for (std::size_t i = 0; i < parts; ++i) {
+            runs.emplace_back(l.get_allocator());
+        }
+        std::size_t chunk = n / parts;
+        for (std::size_t i = 0; i + 1 < parts; ++i) {
+            auto last = l.begin();
+            std::advance(last,chunk);
+            runs[i].splice(runs[i].end(),l,l.begin(),last);
+        }
+        runs[parts-1].splice(runs[parts-1].end(),l);
+
+        parallel_for(0,parts,[&runs,&comp](std::size_t i) { sequential_list_sort(runs[i],comp); },1);
+
+        // merge adjacent runs only, so that equal elements keep their order
+        for (std::size_t width = 1; width < parts; width *= 2) {
+            std::size_t merges = (parts - width + 2 * width - 1) / (2 * width);
+            parallel_for(0,merges,[&runs,&comp,width](std::size_t k) {
+                std::size_t i = 2 * width * k;
+                runs[i].merge(runs[i+width],std::ref(comp));
+            },1);
+        }
+        l.swap(runs[0]);
+    }
+
+    template <typename L, typename Compare>
+    void list_sort(L &l, Compare comp)
+    {
+        l.sort(comp);
+    }
+
+    template <typename T, typename A, typename Compare>
+    void list_merge(std::list<T,A> &into, std::list<T,A> &from, Compare comp)
+    {
+        if (into.get_allocator() != from.get_allocator()) {
+            std::list<T,A> other(from.begin(),from.end(),into.get_allocator());
+            from.clear();
+            into.merge(other,comp);
+            return;
+        }
+        into.merge(from,comp);
+    }
+
+    template <typename L, typename Compare>
+    void list_merge(L &into, L &from, Compare comp)
+    {
+        L merged;
+        std::merge(into.begin(),into.end(),from.begin(),from.end(),
+                   std::back_inserter(merged),comp);
+        into.swap(merged);
+        from.clear();
+    }
+
+    template <typename T, typename A, typename Predicate>
+    void list_partition(std::list<T,A> &l, std::list<T,A> &rejected, Predicate predicate)
+    {
+        for (auto i = l.begin(); i != l.end(); ) {
+            auto next = std::next(i);
+            if (!predicate(*i))
+                list_relink(rejected,l,i,next);
+            i = next;
+        }
+    }
+
+    template <typename L, typename Predicate>
+    void list_partition(L &l, L &rejected, Predicate predicate)
+    {
+        L accepted;
+        for (auto const &i: l) {
+            if (predicate(i))
+                accepted.push_back(i);
+            else
+                rejected.push_back(i);
+        }
+        l.swap(accepted);
+    }
+
+    template <typename T, typename A>
+    void list_relink(std::list<T,A> &to, std::list<T,A> &from,
+                     typename std::list<T,A>::iterator first, typename std::list<T,A>::iterator last)
+    {
+        if (to.get_allocator() == from.get_allocator()) {
+            to.splice(to.end(),from,first,last);
+            return;
+        }
+        to.insert(to.end(),std::make_move_iterator(first),std::make_move_iterator(last));
+        from.erase(first,last);
+    }
+
+    template <typename L>
+    void list_relink(L &to, L &from, typename L::iterator first, typename L::iterator last)
+    {
+        to.splice(to.end(),from,first,last);
+    }
 }
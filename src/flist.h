@@ -13,14 +13,49 @@
 #include <map>
 #include <tuple>
 #include <functional>
+#include "bloom.h"
+#include "algorithms.h"
+#include "unrolled_list.h"
+#include "pool_allocator.h"
+#include "scheduler.h"
+#include "zip.h"
+#include "random.h"
+#include "mem_scope.h"
 
+/*
+ * The storage used by `flist` when no backend is given. Define it before
+ * including the library to change it for every flist, e.g.
+ *
+ *     #define FNC_LIST_BACKEND fnc::unrolled_list
+ *     #define FNC_LIST_BACKEND fnc::pooled_list
+ *     #define FNC_LIST_BACKEND fnc::tracked_list
+ */
+#ifndef FNC_LIST_BACKEND
+#define FNC_LIST_BACKEND std::list
+#endif
+
+/*
+ * The size above which `list_sort` sorts the parts of a std::list on
+ * different threads: each thread sorts at least this many elements.
+ */
+#ifndef FNC_PARALLEL_SORT_THRESHOLD
+#define FNC_PARALLEL_SORT_THRESHOLD 65536
+#endif
 
 namespace fnc {
 
-    template <typename T>
-    class flist : public std::list<T> {
+    /*
+     * `flist` is a functional list on top of a list-like container,
+     * `Backend<T>`: std::list by default, `unrolled_list` for lists
+     * that are scanned far more often than they are edited, or
+     * `pooled_list` to take the nodes from a `node_pool`.
+     */
+    template <typename T, template <typename...> class Backend = FNC_LIST_BACKEND>
+    class flist : public Backend<T> {
     
     public :
+        typedef Backend<T> backend;
+
         flist();
 
         flist(std::list<T> l);
@@ -34,18 +69,21 @@ namespace fnc {
 
         /*
          * `drop` drops the first n elements of the flist.
+         * Only the remaining elements are copied; on a temporary flist the
+         * first n nodes are unlinked and none is copied.
          */
-        flist<T> drop(int n);
+        flist<T,Backend> drop(int n) &;
+        flist<T,Backend> drop(int n) &&;
 
         /*
          * `tail` returns the flist with the first element dropped.
          */
-        flist<T> tail();
+        flist<T,Backend> tail();
 
         /*
          * `init` returns the flist with the last element dropped.
          */
-        flist<T> init();
+        flist<T,Backend> init();
 
         /*
          * `last` returns the last element of the flist.
@@ -54,13 +92,44 @@ namespace fnc {
 
         /*
          * `take` returns the first n elements of the flist.
+         * On a temporary flist the nodes after the first n are unlinked
+         * and none is copied.
+         */
+        flist<T,Backend> take(int n) &;
+        flist<T,Backend> take(int n) &&;
+
+        /*
+         * `take_while` returns the longest prefix of elements that fullfill
+         * the predicate, `drop_while` the rest of the flist. Finding the cut
+         * costs O(k); on a temporary flist no element is copied.
          */
-        flist<T> take(int n);
+        flist<T,Backend> take_while(std::function<bool(T)> predicate) &;
+        flist<T,Backend> take_while(std::function<bool(T)> predicate) &&;
+
+        flist<T,Backend> drop_while(std::function<bool(T)> predicate) &;
+        flist<T,Backend> drop_while(std::function<bool(T)> predicate) &&;
+
+        /*
+         * `split_at` returns the tuple <take(n),drop(n)>. On a temporary
+         * flist the first n nodes are relinked into the first flist, in
+         * O(n), and the second one is the flist itself.
+         */
+        std::tuple<flist<T,Backend>,flist<T,Backend>> split_at(int n) &;
+        std::tuple<flist<T,Backend>,flist<T,Backend>> split_at(int n) &&;
+
+        /*
+         * `partition` returns the tuple of the elements that fullfill the
+         * predicate and of those that do not, both in their original order.
+         * On a temporary flist the rejected nodes are relinked one by one
+         * into the second flist and no element is copied.
+         */
+        std::tuple<flist<T,Backend>,flist<T,Backend>> partition(std::function<bool(T)> predicate) &;
+        std::tuple<flist<T,Backend>,flist<T,Backend>> partition(std::function<bool(T)> predicate) &&;
 
         /*
          * `copy` returns a copy of the flist.
          */
-        flist<T> copy();
+        flist<T,Backend> copy();
 
         /*
          * - f : a function;
@@ -106,27 +175,27 @@ namespace fnc {
          */
         T foldl(std::function<T(T,T)> f, T base);
 
-        flist<T> scanr(std::function<T(T,T)> f, T base);
+        flist<T,Backend> scanr(std::function<T(T,T)> f, T base);
 
-        flist<T> scanl(std::function<T(T,T)> f, T base);
+        flist<T,Backend> scanl(std::function<T(T,T)> f, T base);
 
         /*
          * `group` returns an flist of flist, grouped by the predicate `f`
          */
-        flist<flist<T> > group();
+        flist<flist<T,Backend>,Backend> group();
 
         /*
          *
          *
          */
-        flist<flist<T> > clusterize_by(std::function<bool(T,T)> f);
+        flist<flist<T,Backend>,Backend> clusterize_by(std::function<bool(T,T)> f);
 
         /*
          *  `clusterize` is just a shortcut for:
          *
          *      clusterize_by([](int x, int y) {return x == y; });
          */
-        flist<flist<T> > clusterize();
+        flist<flist<T,Backend>,Backend> clusterize();
 
         /*
          * `map` applies to each element of the flist the function
@@ -135,7 +204,7 @@ namespace fnc {
          *
          * and then returns the flist of mapped elements.
          */
-        flist<T> map(std::function<T(T)> f);
+        flist<T,Backend> map(std::function<T(T)> f);
 
         /*
          * `filter` returns an flist with the elements that fullfill the
@@ -143,37 +212,64 @@ namespace fnc {
          *
          *    f: T --> bool
          */
-        flist<T> filter(std::function<bool(T)> predicate);
+        flist<T,Backend> filter(std::function<bool(T)> predicate);
 
         /*
-         * `zip` takes two lists and returns an flist of corresponding pairs. 
-         * The length of the flist is equal to the length of the shortest flist.
+         * `zip` takes two lists and returns an flist of corresponding pairs,
+         * as tuples. The length of the flist is equal to the length of the
+         * shortest flist.
          */
-        flist<flist<T>> zip(flist<T> other);
+        template <typename U>
+        flist<std::tuple<T,U>,Backend> zip(const flist<U,Backend> &other);
 
         /*
-         * `zip_with` does the same as `zip`, but you have to specify the
-         * comparator function (recommended for custom objects)
+         * `zip_with` returns the flist of f(x,y) for the corresponding
+         * elements x and y, with the type returned by `f`.
          */
-        flist<T> zip_with(flist<T> other, std::function<bool(T,T)> f);
+        template <typename U, typename F>
+        flist<typename std::decay<decltype(std::declval<F &>()(std::declval<T &>(),
+                                                               std::declval<const U &>()))>::type,Backend>
+        zip_with(const flist<U,Backend> &other, F f);
 
-        flist<T> concat(flist<T> other);
+        /*
+         * `concat` relinks the nodes of `other` at the end of the flist, in
+         * O(1): only the elements of this flist are copied, and none of
+         * them if it is a temporary.
+         */
+        flist<T,Backend> concat(flist<T,Backend> other) &;
+        flist<T,Backend> concat(flist<T,Backend> other) &&;
 
-        flist<flist<T>> inits();
+        flist<flist<T,Backend>,Backend> inits();
 
-        flist<flist<T>> tails();
+        flist<flist<T,Backend>,Backend> tails();
 
-        flist<T> unite(flist<T> other);
+        flist<T,Backend> unite(flist<T,Backend> other);
 
-        flist<T> intersecate(flist<T> other);
+        flist<T,Backend> intersecate(flist<T,Backend> other);
 
-        flist<T> distinct();
+        /*
+         * `intersecate` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this flist rejected by the filter skip the lookup in
+         * `other`, and the others are looked up in it directly.
+         */
+        template <typename S, typename H>
+        flist<T,Backend> intersecate(const S &other, const bloom<T,H> &filter);
+
+        flist<T,Backend> distinct();
 
         inline bool any(T elem);
 
-        inline flist<T> singleton(T element);
+        /*
+         * `any` with a bloom filter built from this flist: if the filter
+         * rejects `elem` the flist is not scanned at all.
+         */
+        template <typename H>
+        inline bool any(T elem, const bloom<T,H> &filter);
+
+        inline flist<T,Backend> singleton(T element);
 
-        flist<T> reverse();
+        flist<T,Backend> reverse();
 
         /*
          * `sum` returns the sum of the elements.
@@ -207,33 +303,132 @@ namespace fnc {
 
         void foreach(std::function<void(T)> action);
 
-        template <typename U> flist<U> select(std::function<U(T)> selector);
+        template <typename U> flist<U,Backend> select(std::function<U(T)> selector);
 
-        flist<T> except(flist<T> other);
+        flist<T,Backend> except(flist<T,Backend> other);
 
-        flist<T> sort(std::function<bool(T,T)> comparator);
+        /*
+         * `except` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this flist rejected by the filter are kept without the
+         * lookup in `other`.
+         */
+        template <typename S, typename H>
+        flist<T,Backend> except(const S &other, const bloom<T,H> &filter);
 
-        flist<T> sort();
+        /*
+         * `sort` returns the flist sorted (stably) by `comparator`, which
+         * must be a strict weak ordering, like (<).
+         * The copy is sorted by relinking its nodes: see `list_sort`.
+         */
+        flist<T,Backend> sort(std::function<bool(T,T)> comparator);
 
-        flist<T> sort_heap(std::function<bool(T,T)> comparator);
+        flist<T,Backend> sort();
 
-        flist<T> sort_heap();
+        /*
+         * A list has no random access to build a heap on: `sort_heap` is
+         * the same as `sort`.
+         */
+        flist<T,Backend> sort_heap(std::function<bool(T,T)> comparator);
 
-        flist<T> intersperse(T elem);
+        flist<T,Backend> sort_heap();
 
-        flist<T> rotate_left(int n_positions);
+        /*
+         * `merge` merges two flists already sorted by `comparator` in
+         * O(n+m), by relinking the nodes of `other`. The merge is stable:
+         * the elements of this flist come before the equal ones of `other`.
+         */
+        flist<T,Backend> merge(flist<T,Backend> other, std::function<bool(T,T)> comparator);
 
-        flist<T> shuffle();
+        flist<T,Backend> merge(flist<T,Backend> other);
+
+        flist<T,Backend> intersperse(T elem);
+
+        /*
+         * `rotate_left` moves the first n_positions elements (modulo the
+         * size) at the end of the flist. On a temporary flist their nodes
+         * are relinked, in O(n_positions), and no element is copied.
+         */
+        flist<T,Backend> rotate_left(int n_positions) &;
+        flist<T,Backend> rotate_left(int n_positions) &&;
+
+        /*
+         * `shuffle` returns the elements in random order, drawn from
+         * `thread_rng`, or reproducibly from `seed`.
+         */
+        flist<T,Backend> shuffle();
+
+        flist<T,Backend> shuffle(std::uint64_t seed);
         
     private :
+        /*
+         * `position` returns the iterator to the n-th element, clamping n
+         * to [0,size].
+         */
+        typename backend::iterator position(int n);
+
         template <typename U>
-        inline bool map_contains(std::map<T,U> m, T val);
+        inline bool map_contains(const std::map<T,U> &m, T val);
         
     };
 
     flist<int> lrange(int start, int stop, int step);
     inline flist<int> lrange(int stop, int step);
-    template <typename T> flist<T> cycle(flist<T> vec, int n);
+    template <typename T, template <typename...> class Backend>
+    flist<T,Backend> cycle(flist<T,Backend> vec, int n);
+
+    /*
+     * `list_sort` is a bottom-up merge sort for std::list: it only
+     * relinks the nodes with `splice`, never copying or moving an element,
+     * and it is stable.
+     *
+     * Lists longer than 2 * FNC_PARALLEL_SORT_THRESHOLD are cut into one
+     * part per thread of `scheduler::instance()`, sorted in parallel and
+     * then merged pairwise, each round of merges in parallel.
+     * WARNING: in that case `comp` is called concurrently, and it must not
+     * throw.
+     *
+     * Other backends fall back to their own `sort`.
+     */
+    template <typename T, typename A, typename Compare>
+    void list_sort(std::list<T,A> &l, Compare comp);
+
+    template <typename L, typename Compare>
+    void list_sort(L &l, Compare comp);
+
+    /*
+     * `list_merge` merges `from` into `into`, both sorted by `comp`;
+     * `from` is left empty. For std::list the nodes are relinked.
+     */
+    template <typename T, typename A, typename Compare>
+    void list_merge(std::list<T,A> &into, std::list<T,A> &from, Compare comp);
+
+    template <typename L, typename Compare>
+    void list_merge(L &into, L &from, Compare comp);
+
+    /*
+     * `list_partition` moves the elements of `l` that do not fullfill the
+     * predicate at the end of `rejected`, keeping their order. For
+     * std::list the nodes are relinked one by one.
+     */
+    template <typename T, typename A, typename Predicate>
+    void list_partition(std::list<T,A> &l, std::list<T,A> &rejected, Predicate predicate);
+
+    template <typename L, typename Predicate>
+    void list_partition(L &l, L &rejected, Predicate predicate);
+
+    /*
+     * `list_relink` moves [first,last) of `from` at the end of `to` by
+     * relinking the nodes. Two std::lists with different allocators (e.g.
+     * `tracking_allocator`s of different `mem_scope`s) cannot exchange
+     * nodes: the elements are moved instead.
+     */
+    template <typename T, typename A>
+    void list_relink(std::list<T,A> &to, std::list<T,A> &from,
+                     typename std::list<T,A>::iterator first, typename std::list<T,A>::iterator last);
+
+    template <typename L>
+    void list_relink(L &to, L &from, typename L::iterator first, typename L::iterator last);
 
 }
 
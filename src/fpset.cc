@@ -0,0 +1,382 @@
+/*
+ *  collection/src/fpset.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <bitset>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T, typename Hash, typename Eq>
+    const unsigned fpset<T,Hash,Eq>::bits;
+
+    template <typename T, typename Hash, typename Eq>
+    const unsigned fpset<T,Hash,Eq>::hash_bits;
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq>::fpset() : root(nullptr), count(0) {}
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq>::fpset(std::initializer_list<T> l) : root(nullptr), count(0)
+    {
+        for (auto const &i: l) {
+            *this = this->insert(i);
+        }
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq>::fpset(node_ptr root, std::size_t count) : root(root), count(count) {}
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::size_t fpset<T,Hash,Eq>::size() const { return count; }
+
+    template <typename T, typename Hash, typename Eq>
+    inline bool fpset<T,Hash,Eq>::empty() const { return count == 0; }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::insert(T elem) const
+    {
+        if (root == nullptr) {
+            std::shared_ptr<node> n = std::make_shared<node>();
+            n->datamap = 1u << index_of(hash_of(elem),0);
+            n->values.push_back(elem);
+            return fpset<T,Hash,Eq>(n,1);
+        }
+
+        bool added = false;
+        node_ptr r = insert_node(root,elem,hash_of(elem),0,added);
+        return fpset<T,Hash,Eq>(r,count + (added ? 1 : 0));
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::erase(T elem) const
+    {
+        if (root == nullptr) return *this;
+
+        bool removed = false;
+        node_ptr r = erase_node(root,elem,hash_of(elem),0,removed);
+        if (!removed) return *this;
+        return fpset<T,Hash,Eq>(r,count - 1);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    bool fpset<T,Hash,Eq>::any(T elem) const
+    {
+        std::uint64_t h = hash_of(elem);
+        const node *n = root.get();
+
+        for (unsigned shift = 0; n != nullptr; shift += bits) {
+            if (n->collision) {
+                for (auto const &v: n->values) {
+                    if (equal(v,elem)) return true;
+                }
+                return false;
+            }
+
+            std::uint32_t bit = 1u << index_of(h,shift);
+            if (n->datamap & bit)
+                return equal(n->values[position(n->datamap,bit)],elem);
+            if (!(n->nodemap & bit))
+                return false;
+            n = n->children[position(n->nodemap,bit)].get();
+        }
+        return false;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::copy() const { return *this; }
+
+    template <typename T, typename Hash, typename Eq>
+    std::vector<T> fpset<T,Hash,Eq>::to_vector() const
+    {
+        std::vector<T> v;
+        v.reserve(count);
+        this->foreach([&v](T x) { v.push_back(x); });
+        return v;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::map(std::function<T(T)> f) const
+    {
+        fpset<T,Hash,Eq> set;
+        this->foreach([&set,&f](T x) { set = set.insert(f(x)); });
+        return set;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::filter(std::function<bool(T)> predicate) const
+    {
+        fpset<T,Hash,Eq> set(*this);
+        this->foreach([&set,&predicate](T x) {
+            if (!predicate(x))
+                set = set.erase(x);
+        });
+        return set;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::unite(fpset<T,Hash,Eq> other) const
+    {
+        fpset<T,Hash,Eq> united = count >= other.count ? *this : other;
+        const fpset<T,Hash,Eq> &smaller = count >= other.count ? other : *this;
+
+        smaller.foreach([&united](T x) { united = united.insert(x); });
+        return united;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::intersecate(fpset<T,Hash,Eq> other) const
+    {
+        fpset<T,Hash,Eq> intersected = count <= other.count ? *this : other;
+        const fpset<T,Hash,Eq> &larger = count <= other.count ? other : *this;
+
+        intersected.foreach([&intersected,&larger](T x) {
+            if (!larger.any(x))
+                intersected = intersected.erase(x);
+        });
+        return intersected;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::except(fpset<T,Hash,Eq> other) const
+    {
+        fpset<T,Hash,Eq> res(*this);
+        if (other.count < count) {
+            other.foreach([&res](T x) { res = res.erase(x); });
+        } else {
+            this->foreach([&res,&other](T x) {
+                if (other.any(x))
+                    res = res.erase(x);
+            });
+        }
+        return res;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    fpset<T,Hash,Eq> fpset<T,Hash,Eq>::singleton(T element) const
+    {
+        return fpset<T,Hash,Eq>().insert(element);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fpset<T,Hash,Eq>::sum() const
+    {
+        T sum = 0;
+        this->foreach([&sum](T x) { sum += x; });
+        return sum;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fpset<T,Hash,Eq>::product() const
+    {
+        T product = 1;
+        this->foreach([&product](T x) { product *= x; });
+        return product;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fpset<T,Hash,Eq>::min() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+        return std::get<0>(this->minmax());
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    T fpset<T,Hash,Eq>::max() const
+    {
+        if (this->empty()) throw "Cannot calculate the maximum of an empty set";
+        return std::get<1>(this->minmax());
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    std::tuple<T,T> fpset<T,Hash,Eq>::minmax() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+
+        std::vector<T> v = this->to_vector();
+        auto mm = std::minmax_element(v.begin(),v.end());
+        return std::make_tuple(*mm.first,*mm.second);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fpset<T,Hash,Eq>::foreach(std::function<void(T)> action) const
+    {
+        visit(root.get(),action);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    template <typename U>
+    fpset<U> fpset<T,Hash,Eq>::select(std::function<U(T)> selector) const
+    {
+        fpset<U> res;
+        this->foreach([&res,&selector](T x) { res = res.insert(selector(x)); });
+        return res;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline unsigned fpset<T,Hash,Eq>::index_of(std::uint64_t h, unsigned shift)
+    {
+        return static_cast<unsigned>(h >> shift) & ((1u << bits) - 1);
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline unsigned fpset<T,Hash,Eq>::position(std::uint32_t bitmap, std::uint32_t bit)
+    {
+        return static_cast<unsigned>(std::bitset<32>(bitmap & (bit - 1)).count());
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    inline std::uint64_t fpset<T,Hash,Eq>::hash_of(const T &elem) const
+    {
+        return mix64(static_cast<std::uint64_t>(hasher(elem)));
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fpset<T,Hash,Eq>::node_ptr
+    fpset<T,Hash,Eq>::insert_node(const node_ptr &n, const T &elem, std::uint64_t h,
+                                  unsigned shift, bool &added) const
+    {
+        if (n->collision) {
+            for (auto const &v: n->values) {
+                if (equal(v,elem)) return n;
+            }
+            std::shared_ptr<node> c = std::make_shared<node>(*n);
+            c->values.push_back(elem);
+            added = true;
+            return c;
+        }
+
+        std::uint32_t bit = 1u << index_of(h,shift);
+
+        if (n->datamap & bit) {
+            unsigned pos = position(n->datamap,bit);
+            const T &current = n->values[pos];
+            if (equal(current,elem)) return n;
+
+            // two elements in the same slot: push both one level down
+            node_ptr sub = merge_values(current,hash_of(current),elem,h,shift + bits);
+            std::shared_ptr<node> c = std::make_shared<node>(*n);
+            c->values.erase(c->values.begin() + pos);
+            c->datamap &= ~bit;
+            c->children.insert(c->children.begin() + position(c->nodemap,bit),sub);
+            c->nodemap |= bit;
+            added = true;
+            return c;
+        }
+
+        if (n->nodemap & bit) {
+            unsigned pos = position(n->nodemap,bit);
+            node_ptr sub = insert_node(n->children[pos],elem,h,shift + bits,added);
+            if (sub == n->children[pos]) return n;
+
+            std::shared_ptr<node> c = std::make_shared<node>(*n);
+            c->children[pos] = sub;
+            return c;
+        }
+
+        std::shared_ptr<node> c = std::make_shared<node>(*n);
+        c->values.insert(c->values.begin() + position(n->datamap,bit),elem);
+        c->datamap |= bit;
+        added = true;
+        return c;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fpset<T,Hash,Eq>::node_ptr
+    fpset<T,Hash,Eq>::erase_node(const node_ptr &n, const T &elem, std::uint64_t h,
+                                 unsigned shift, bool &removed) const
+    {
+        if (n->collision) {
+            for (std::size_t i = 0; i < n->values.size(); ++i) {
+                if (equal(n->values[i],elem)) {
+                    std::shared_ptr<node> c = std::make_shared<node>(*n);
+                    c->values.erase(c->values.begin() + i);
+                    removed = true;
+                    return c;
+                }
+            }
+            return n;
+        }
+
+        std::uint32_t bit = 1u << index_of(h,shift);
+
+        if (n->datamap & bit) {
+            unsigned pos = position(n->datamap,bit);
+            if (!equal(n->values[pos],elem)) return n;
+
+            removed = true;
+            if (n->values.size() == 1 && n->children.empty()) return nullptr;
+
+            std::shared_ptr<node> c = std::make_shared<node>(*n);
+            c->values.erase(c->values.begin() + pos);
+            c->datamap &= ~bit;
+            return c;
+        }
+
+        if (n->nodemap & bit) {
+            unsigned pos = position(n->nodemap,bit);
+            node_ptr sub = erase_node(n->children[pos],elem,h,shift + bits,removed);
+            if (sub == n->children[pos]) return n;
+
+            std::shared_ptr<node> c = std::make_shared<node>(*n);
+            if (sub->values.size() == 1 && sub->children.empty()) {
+                // a sub-trie left with a single element is inlined back
+                c->children.erase(c->children.begin() + pos);
+                c->nodemap &= ~bit;
+                c->values.insert(c->values.begin() + position(c->datamap,bit),sub->values[0]);
+                c->datamap |= bit;
+            } else {
+                c->children[pos] = sub;
+            }
+            return c;
+        }
+
+        return n;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    typename fpset<T,Hash,Eq>::node_ptr
+    fpset<T,Hash,Eq>::merge_values(const T &a, std::uint64_t ha, const T &b,
+                                   std::uint64_t hb, unsigned shift) const
+    {
+        std::shared_ptr<node> n = std::make_shared<node>();
+
+        if (shift >= hash_bits) {
+            // the hashes are identical: keep the elements side by side
+            n->collision = true;
+            n->values.push_back(a);
+            n->values.push_back(b);
+            return n;
+        }
+
+        unsigned ia = index_of(ha,shift);
+        unsigned ib = index_of(hb,shift);
+
+        if (ia == ib) {
+            n->nodemap = 1u << ia;
+            n->children.push_back(merge_values(a,ha,b,hb,shift + bits));
+        } else {
+            n->datamap = (1u << ia) | (1u << ib);
+            n->values.push_back(ia < ib ? a : b);
+            n->values.push_back(ia < ib ? b : a);
+        }
+        return n;
+    }
+
+    template <typename T, typename Hash, typename Eq>
+    void fpset<T,Hash,Eq>::visit(const node *n, std::function<void(T)> &action)
+    {
+        if (n == nullptr) return;
+
+        for (auto const &v: n->values) {
+            action(v);
+        }
+        for (auto const &c: n->children) {
+            visit(c.get(),action);
+        }
+    }
+}
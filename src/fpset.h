@@ -0,0 +1,174 @@
+/*
+ *  collection/src/fpset.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fpset_h
+#define fpset_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <functional>
+#include <initializer_list>
+#include "algorithms.h"
+
+namespace fnc {
+
+    /*
+     * `fpset` is a persistent (immutable) unordered set, stored as a hash
+     * array mapped trie (in the compact CHAMP layout: elements are kept
+     * inline in the trie nodes, sub-tries are reached through a second
+     * bitmap).
+     *
+     * `insert` and `erase` never modify the set: they return a new version
+     * that copies only the O(log32 n) nodes on the path to the element and
+     * shares every other node with the previous version. `copy` is O(1).
+     *
+     * Example:
+     *
+     *     fpset<int> v1({1,2,3});
+     *     fpset<int> v2 = v1.insert(4);    // v1 is still {1,2,3}
+     */
+    template <typename T, typename Hash = std::hash<T>, typename Eq = std::equal_to<T> >
+    class fpset {
+
+    public :
+        fpset();
+
+        fpset(std::initializer_list<T> l);
+
+        inline std::size_t size() const;
+
+        inline bool empty() const;
+
+        /*
+         * `insert` returns a new version of the set that also contains
+         * `elem`. If `elem` is already there, the same version is returned.
+         */
+        fpset<T,Hash,Eq> insert(T elem) const;
+
+        /*
+         * `erase` returns a new version of the set without `elem`.
+         * If `elem` is not there, the same version is returned.
+         */
+        fpset<T,Hash,Eq> erase(T elem) const;
+
+        bool any(T elem) const;
+
+        /*
+         * `copy` returns a copy of the fpset in O(1): the two versions
+         * share the whole trie.
+         */
+        fpset<T,Hash,Eq> copy() const;
+
+        std::vector<T> to_vector() const;
+
+        /*
+         * `map` applies to each element of the fpset the function
+         *
+         *    f: T --> T
+         *
+         * and then returns the fpset of mapped elements.
+         */
+        fpset<T,Hash,Eq> map(std::function<T(T)> f) const;
+
+        /*
+         * `filter` returns an fpset with the elements that fullfill the
+         * predicate function
+         *
+         *    f: T --> bool
+         *
+         * The result is derived from this version, so it shares every
+         * sub-trie in which no element was rejected.
+         */
+        fpset<T,Hash,Eq> filter(std::function<bool(T)> predicate) const;
+
+        fpset<T,Hash,Eq> unite(fpset<T,Hash,Eq> other) const;
+
+        fpset<T,Hash,Eq> intersecate(fpset<T,Hash,Eq> other) const;
+
+        fpset<T,Hash,Eq> except(fpset<T,Hash,Eq> other) const;
+
+        fpset<T,Hash,Eq> singleton(T element) const;
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        T sum() const;
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        T product() const;
+
+        /*
+         * `min` returns the minimum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T min() const;
+
+        /*
+         * `max` returns the maximum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T max() const;
+
+        /*
+         * `minmax` returns the tuple <min,max>.
+         */
+        std::tuple<T,T> minmax() const;
+
+        void foreach(std::function<void(T)> action) const;
+
+        template <typename U> fpset<U> select(std::function<U(T)> selector) const;
+
+    private :
+        struct node;
+        typedef std::shared_ptr<const node> node_ptr;
+
+        struct node {
+            std::uint32_t datamap;
+            std::uint32_t nodemap;
+            bool collision;
+            std::vector<T> values;
+            std::vector<node_ptr> children;
+
+            node() : datamap(0), nodemap(0), collision(false) {}
+        };
+
+        static const unsigned bits = 5;
+        static const unsigned hash_bits = 64;
+
+        node_ptr root;
+        std::size_t count;
+        Hash hasher;
+        Eq equal;
+
+        fpset(node_ptr root, std::size_t count);
+
+        static inline unsigned index_of(std::uint64_t h, unsigned shift);
+        static inline unsigned position(std::uint32_t bitmap, std::uint32_t bit);
+
+        inline std::uint64_t hash_of(const T &elem) const;
+        node_ptr insert_node(const node_ptr &n, const T &elem, std::uint64_t h,
+                             unsigned shift, bool &added) const;
+        node_ptr erase_node(const node_ptr &n, const T &elem, std::uint64_t h,
+                            unsigned shift, bool &removed) const;
+        node_ptr merge_values(const T &a, std::uint64_t ha, const T &b,
+                              std::uint64_t hb, unsigned shift) const;
+        static void visit(const node *n, std::function<void(T)> &action);
+    };
+
+}
+
+#include "fpset.cc"
+
+#endif
@@ -0,0 +1,312 @@
+/*
+ *  collection/src/fqueue.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T>
+    const std::size_t fqueue<T>::cache_line;
+
+    template <typename T>
+    const std::size_t fqueue<T>::batch;
+
+    template <typename T>
+    fqueue<T>::fqueue(std::size_t capacity) : tail(0), head(0)
+    {
+        if (capacity == 0) throw "The capacity of a queue must be greater than 0";
+
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+
+        mask = size - 1;
+        cells.reset(new cell[size]);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i,std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    fqueue<T>::~fqueue()
+    {
+        this->pop_batch(this->capacity(),[](T &&) {});
+    }
+
+    template <typename T>
+    inline std::size_t fqueue<T>::capacity() const { return mask + 1; }
+
+    template <typename T>
+    bool fqueue<T>::try_push(T elem)
+    {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        cell *c;
+
+        for (;;) {
+            c = &cells[pos & mask];
+            std::size_t seq = c->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos,pos + 1,std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // the slot still holds the element of the previous lap
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (c->data()) T(std::move(elem));
+        c->sequence.store(pos + 1,std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    bool fqueue<T>::try_pop(T &elem)
+    {
+        return this->pop_batch(1,[&elem](T &&value) { elem = std::move(value); }) == 1;
+    }
+
+    template <typename T>
+    fvec<T> fqueue<T>::try_pop_n(std::size_t n)
+    {
+        fvec<T> popped;
+        popped.reserve(std::min(n,this->capacity()));
+        this->pop_batch(n,[&popped](T &&value) { popped.push_back(std::move(value)); });
+        return popped;
+    }
+
+    template <typename T>
+    std::size_t fqueue<T>::push_all(const fvec<T> &elems)
+    {
+        std::size_t pushed = 0;
+
+        while (pushed < elems.size()) {
+            std::size_t pos = tail.load(std::memory_order_relaxed);
+            std::size_t k = 0;
+
+            // count the free slots following `pos`
+            while (pushed + k < elems.size() && k <= mask) {
+                std::size_t seq = cells[(pos + k) & mask].sequence.load(std::memory_order_acquire);
+                if (seq != pos + k) break;
+                ++k;
+            }
+
+            if (k == 0) {
+                std::size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos) < 0)
+                    return pushed;
+                continue;
+            }
+            if (!tail.compare_exchange_weak(pos,pos + k,std::memory_order_relaxed))
+                continue;
+
+            for (std::size_t i = 0; i < k; ++i) {
+                cell &c = cells[(pos + i) & mask];
+                new (c.data()) T(elems[pushed + i]);
+                c.sequence.store(pos + i + 1,std::memory_order_release);
+            }
+            pushed += k;
+        }
+
+        return pushed;
+    }
+
+    template <typename T>
+    template <template <typename...> class Backend>
+    std::size_t fqueue<T>::drain_to(flist<T,Backend> &list)
+    {
+        std::size_t drained = 0;
+        std::size_t popped;
+        do {
+            popped = this->pop_batch(batch,[&list](T &&value) { list.push_back(std::move(value)); });
+            drained += popped;
+        } while (popped == batch);
+
+        return drained;
+    }
+
+    template <typename T>
+    std::size_t fqueue<T>::size_approx() const
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t h = head.load(std::memory_order_relaxed);
+        return t > h ? t - h : 0;
+    }
+
+    template <typename T>
+    template <typename F>
+    std::size_t fqueue<T>::pop_batch(std::size_t n, F sink)
+    {
+        if (n == 0) return 0;
+
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        std::size_t k;
+
+        for (;;) {
+            // count the ready slots following `pos`
+            k = 0;
+            while (k < n && k <= mask) {
+                std::size_t seq = cells[(pos + k) & mask].sequence.load(std::memory_order_acquire);
+                if (seq != pos + k + 1) break;
+                ++k;
+            }
+
+            if (k == 0) {
+                std::size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1) < 0)
+                    return 0;
+                pos = head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_weak(pos,pos + k,std::memory_order_relaxed))
+                break;
+        }
+
+        for (std::size_t i = 0; i < k; ++i) {
+            cell &c = cells[(pos + i) & mask];
+            sink(std::move(*c.data()));
+            c.data()->~T();
+            c.sequence.store(pos + i + mask + 1,std::memory_order_release);
+        }
+        return k;
+    }
+
+    template <typename T>
+    mpsc_queue<T>::mpsc_queue()
+    {
+        // `tail` always points to a stub node, whose element was popped
+        node *stub = new_node();
+        head.store(stub,std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    template <typename T>
+    mpsc_queue<T>::~mpsc_queue()
+    {
+        this->pop_batch(static_cast<std::size_t>(-1),[](T &&) {});
+        free_node(tail);
+    }
+
+    template <typename T>
+    void mpsc_queue<T>::push(T elem)
+    {
+        node *n = new_node();
+        try {
+            new (n->data()) T(std::move(elem));
+        } catch (...) {
+            free_node(n);
+            throw;
+        }
+
+        node *prev = head.exchange(n,std::memory_order_acq_rel);
+        prev->next.store(n,std::memory_order_release);
+    }
+
+    template <typename T>
+    void mpsc_queue<T>::push_all(const fvec<T> &elems)
+    {
+        if (elems.empty()) return;
+
+        node *first = nullptr;
+        node *last = nullptr;
+        try {
+            for (auto const &i: elems) {
+                node *n = new_node();
+                try {
+                    new (n->data()) T(i);
+                } catch (...) {
+                    free_node(n);
+                    throw;
+                }
+                if (last == nullptr)
+                    first = n;
+                else
+                    last->next.store(n,std::memory_order_relaxed);
+                last = n;
+            }
+        } catch (...) {
+            while (first != nullptr) {
+                node *next = first->next.load(std::memory_order_relaxed);
+                first->data()->~T();
+                free_node(first);
+                first = next;
+            }
+            throw;
+        }
+
+        node *prev = head.exchange(last,std::memory_order_acq_rel);
+        prev->next.store(first,std::memory_order_release);
+    }
+
+    template <typename T>
+    bool mpsc_queue<T>::try_pop(T &elem)
+    {
+        return this->pop_batch(1,[&elem](T &&value) { elem = std::move(value); }) == 1;
+    }
+
+    template <typename T>
+    fvec<T> mpsc_queue<T>::try_pop_n(std::size_t n)
+    {
+        fvec<T> popped;
+        this->pop_batch(n,[&popped](T &&value) { popped.push_back(std::move(value)); });
+        return popped;
+    }
+
+    template <typename T>
+    template <template <typename...> class Backend>
+    std::size_t mpsc_queue<T>::drain_to(flist<T,Backend> &list)
+    {
+        return this->pop_batch(static_cast<std::size_t>(-1),
+                               [&list](T &&value) { list.push_back(std::move(value)); });
+    }
+
+    template <typename T>
+    bool mpsc_queue<T>::empty() const
+    {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    template <typename T>
+    typename mpsc_queue<T>::node *mpsc_queue<T>::new_node()
+    {
+        node *n = new (pool_allocator<node>().allocate(1)) node;
+        n->next.store(nullptr,std::memory_order_relaxed);
+        return n;
+    }
+
+    template <typename T>
+    void mpsc_queue<T>::free_node(node *n)
+    {
+        pool_allocator<node>().deallocate(n,1);
+    }
+
+    template <typename T>
+    template <typename F>
+    std::size_t mpsc_queue<T>::pop_batch(std::size_t n, F sink)
+    {
+        std::size_t popped = 0;
+
+        while (popped < n) {
+            node *next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) break;
+
+            // `next` becomes the stub: its element is moved out
+            sink(std::move(*next->data()));
+            next->data()->~T();
+            free_node(tail);
+            tail = next;
+            popped++;
+        }
+        return popped;
+    }
+}
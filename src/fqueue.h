@@ -0,0 +1,177 @@
+/*
+ *  collection/src/fqueue.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fqueue_h
+#define fqueue_h
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+#include "flist.h"
+#include "fvec.h"
+#include "pool_allocator.h"
+
+namespace fnc {
+
+    /*
+     * `fqueue` is a bounded, lock-free, multi-producer multi-consumer FIFO
+     * queue on a ring buffer (D. Vyukov's design): every slot carries a
+     * sequence number telling whether it is ready to be written or read,
+     * so producers and consumers only contend on their own counter.
+     *
+     * The capacity is rounded up to a power of two. `try_pop_n` and
+     * `push_all` claim a run of slots with a single CAS.
+     *
+     * Example:
+     *
+     *     fqueue<int> q(1024);
+     *     q.try_push(1);                 // producer threads
+     *     flist<int> work;
+     *     q.drain_to(work);              // consumer threads
+     *
+     * WARNING: the move constructor of T must not throw.
+     */
+    template <typename T>
+    class fqueue {
+
+    public :
+        fqueue(std::size_t capacity);
+
+        fqueue(const fqueue<T> &other) = delete;
+
+        fqueue<T> &operator=(const fqueue<T> &other) = delete;
+
+        ~fqueue();
+
+        inline std::size_t capacity() const;
+
+        /*
+         * `try_push` appends `elem` and returns true, or returns false if
+         * the queue is full.
+         */
+        bool try_push(T elem);
+
+        /*
+         * `try_pop` moves the first element into `elem` and returns true,
+         * or returns false if the queue is empty.
+         */
+        bool try_pop(T &elem);
+
+        /*
+         * `try_pop_n` pops up to n elements, as many as are ready.
+         */
+        fvec<T> try_pop_n(std::size_t n);
+
+        /*
+         * `push_all` pushes the elements of `elems` in order, until the
+         * queue is full, and returns the number of elements pushed.
+         */
+        std::size_t push_all(const fvec<T> &elems);
+
+        /*
+         * `drain_to` pops all the elements ready, appending them to `list`,
+         * and returns how many they were.
+         */
+        template <template <typename...> class Backend>
+        std::size_t drain_to(flist<T,Backend> &list);
+
+        /*
+         * `size_approx` is exact only when no thread is pushing or popping.
+         */
+        std::size_t size_approx() const;
+
+    private :
+        static const std::size_t cache_line = 64;
+        static const std::size_t batch = 64;
+
+        struct cell {
+            std::atomic<std::size_t> sequence;
+            typename std::aligned_storage<sizeof(T),alignof(T)>::type storage;
+
+            inline T *data() { return reinterpret_cast<T *>(&storage); }
+        };
+
+        // head and tail on their own cache lines, away from the slots
+        char pad0[cache_line];
+        std::atomic<std::size_t> tail;
+        char pad1[cache_line - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> head;
+        char pad2[cache_line - sizeof(std::atomic<std::size_t>)];
+        std::size_t mask;
+        std::unique_ptr<cell[]> cells;
+
+        template <typename F>
+        std::size_t pop_batch(std::size_t n, F sink);
+    };
+
+    /*
+     * `mpsc_queue` is an unbounded multi-producer single-consumer FIFO
+     * queue on a linked list (D. Vyukov's design). Pushing is wait-free: a
+     * single atomic exchange, for one element or for a whole `push_all`.
+     * The nodes come from a `node_pool`.
+     *
+     * Only one thread at a time may call `try_pop`, `try_pop_n`,
+     * `drain_to` and `empty`.
+     *
+     * WARNING: an element whose push is in progress may not be visible to
+     * the consumer yet, even if elements pushed after it are.
+     */
+    template <typename T>
+    class mpsc_queue {
+
+    public :
+        mpsc_queue();
+
+        mpsc_queue(const mpsc_queue<T> &other) = delete;
+
+        mpsc_queue<T> &operator=(const mpsc_queue<T> &other) = delete;
+
+        ~mpsc_queue();
+
+        void push(T elem);
+
+        /*
+         * `push_all` links the elements of `elems` into a chain and then
+         * publishes the whole chain with a single exchange.
+         */
+        void push_all(const fvec<T> &elems);
+
+        bool try_pop(T &elem);
+
+        fvec<T> try_pop_n(std::size_t n);
+
+        template <template <typename...> class Backend>
+        std::size_t drain_to(flist<T,Backend> &list);
+
+        bool empty() const;
+
+    private :
+        struct node {
+            std::atomic<node *> next;
+            typename std::aligned_storage<sizeof(T),alignof(T)>::type storage;
+
+            inline T *data() { return reinterpret_cast<T *>(&storage); }
+        };
+
+        std::atomic<node *> head;
+        char pad[64 - sizeof(std::atomic<node *>)];
+        node *tail;
+
+        static node *new_node();
+        static void free_node(node *n);
+
+        template <typename F>
+        std::size_t pop_batch(std::size_t n, F sink);
+    };
+
+}
+
+#include "fqueue.cc"
+
+#endif
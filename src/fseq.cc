@@ -0,0 +1,477 @@
+/*
+ *  collection/src/fseq.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T>
+    typename fseq<T>::const_iterator &fseq<T>::const_iterator::operator++()
+    {
+        const node *n = path.back();
+        path.pop_back();
+        push_left(n->right);
+        return *this;
+    }
+
+    template <typename T>
+    void fseq<T>::const_iterator::push_left(const node *n)
+    {
+        for (; n != nullptr; n = n->left) {
+            path.push_back(n);
+        }
+    }
+
+    template <typename T>
+    fseq<T>::fseq() : fseq(static_cast<node *>(nullptr)) {}
+
+    template <typename T>
+    fseq<T>::fseq(std::initializer_list<T> l) : fseq(std::vector<T>(l)) {}
+
+    template <typename T>
+    fseq<T>::fseq(std::vector<T> v) : fseq(static_cast<node *>(nullptr))
+    {
+        root = build(v,state);
+    }
+
+    template <typename T>
+    fseq<T>::fseq(const fseq<T> &other) : fseq(copy_of(other.root)) {}
+
+    template <typename T>
+    fseq<T>::fseq(fseq<T> &&other) : fseq(other.root)
+    {
+        other.root = nullptr;
+    }
+
+    template <typename T>
+    fseq<T>::fseq(node *root) : root(root)
+    {
+        // splitmix64 of the address: distinct seeds for distinct fseqs
+        std::uint64_t x = reinterpret_cast<std::uintptr_t>(this);
+        state = splitmix64(x) | 1;
+    }
+
+    template <typename T>
+    fseq<T>::~fseq() { destroy(root); }
+
+    template <typename T>
+    fseq<T> &fseq<T>::operator=(fseq<T> other)
+    {
+        std::swap(root,other.root);
+        return *this;
+    }
+
+    template <typename T>
+    inline std::size_t fseq<T>::size() const { return size_of(root); }
+
+    template <typename T>
+    inline bool fseq<T>::empty() const { return root == nullptr; }
+
+    template <typename T>
+    typename fseq<T>::const_iterator fseq<T>::begin() const
+    {
+        const_iterator it;
+        it.push_left(root);
+        return it;
+    }
+
+    template <typename T>
+    typename fseq<T>::const_iterator fseq<T>::end() const
+    {
+        return const_iterator();
+    }
+
+    template <typename T>
+    std::vector<T> fseq<T>::to_vector() const
+    {
+        std::vector<T> v;
+        v.reserve(this->size());
+        for (auto const &i: *this) {
+            v.push_back(i);
+        }
+        return v;
+    }
+
+    template <typename T>
+    const T &fseq<T>::at(std::size_t i) const
+    {
+        if (i >= this->size()) throw "Index out of range";
+
+        const node *n = root;
+        for (;;) {
+            std::size_t left = size_of(n->left);
+            if (i < left) {
+                n = n->left;
+            } else if (i == left) {
+                return n->value;
+            } else {
+                i -= left + 1;
+                n = n->right;
+            }
+        }
+    }
+
+    template <typename T>
+    void fseq<T>::set(std::size_t i, T value)
+    {
+        const_cast<T &>(this->at(i)) = value;
+    }
+
+    template <typename T>
+    void fseq<T>::push_front(T elem)
+    {
+        this->insert_at(0,elem);
+    }
+
+    template <typename T>
+    void fseq<T>::push_back(T elem)
+    {
+        this->insert_at(this->size(),elem);
+    }
+
+    template <typename T>
+    void fseq<T>::insert_at(std::size_t i, T elem)
+    {
+        if (i > this->size()) throw "Index out of range";
+
+        node *n = new node(elem,this->next_priority());
+        node *a, *b;
+        split(root,i,a,b);
+        root = join(join(a,n),b);
+    }
+
+    template <typename T>
+    void fseq<T>::erase_at(std::size_t i)
+    {
+        if (i >= this->size()) throw "Index out of range";
+
+        node *a, *b, *erased;
+        split(root,i,a,b);
+        split(b,1,erased,b);
+        destroy(erased);
+        root = join(a,b);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::concat(fseq<T> other) &
+    {
+        return fseq<T>(*this).concat(std::move(other));
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::concat(fseq<T> other) &&
+    {
+        root = join(root,other.root);
+        other.root = nullptr;
+        return std::move(*this);
+    }
+
+    template <typename T>
+    std::tuple<fseq<T>,fseq<T>> fseq<T>::split_at(std::size_t i) &
+    {
+        return fseq<T>(*this).split_at(i);
+    }
+
+    template <typename T>
+    std::tuple<fseq<T>,fseq<T>> fseq<T>::split_at(std::size_t i) &&
+    {
+        node *a, *b;
+        split(root,i,a,b);
+        root = nullptr;
+        return std::make_tuple(fseq<T>(a),fseq<T>(b));
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::take(std::size_t n) &
+    {
+        return fseq<T>(*this).take(n);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::take(std::size_t n) &&
+    {
+        node *a, *b;
+        split(root,n,a,b);
+        destroy(b);
+        root = a;
+        return std::move(*this);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::drop(std::size_t n) &
+    {
+        return fseq<T>(*this).drop(n);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::drop(std::size_t n) &&
+    {
+        node *a, *b;
+        split(root,n,a,b);
+        destroy(a);
+        root = b;
+        return std::move(*this);
+    }
+
+    template <typename T>
+    T fseq<T>::foldr(std::function<T(T,T)> f, T base) const
+    {
+        std::vector<T> v = this->to_vector();
+        T acc = base;
+        for (auto i = v.rbegin(); i != v.rend(); ++i) {
+            acc = f(*i,acc);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    T fseq<T>::foldl(std::function<T(T,T)> f, T base) const
+    {
+        T acc = base;
+        for (auto const &i: *this) {
+            acc = f(acc,i);
+        }
+        return acc;
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::map(std::function<T(T)> f) const
+    {
+        std::vector<T> mapped;
+        mapped.reserve(this->size());
+        for (auto const &i: *this) {
+            mapped.push_back(f(i));
+        }
+        return fseq<T>(mapped);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::filter(std::function<bool(T)> predicate) const
+    {
+        std::vector<T> filtered;
+        for (auto const &i: *this) {
+            if (predicate(i))
+                filtered.push_back(i);
+        }
+        return fseq<T>(filtered);
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::reverse() const
+    {
+        std::vector<T> v = this->to_vector();
+        std::reverse(v.begin(),v.end());
+        return fseq<T>(v);
+    }
+
+    template <typename T>
+    bool fseq<T>::any(T elem) const
+    {
+        return std::find(this->begin(),this->end(),elem) != this->end();
+    }
+
+    template <typename T>
+    fseq<T> fseq<T>::singleton(T element) const
+    {
+        return fseq<T>(std::vector<T>(1,element));
+    }
+
+    template <typename T>
+    T fseq<T>::sum() const
+    {
+        T sum = 0;
+        for (auto const &i: *this) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    template <typename T>
+    T fseq<T>::product() const
+    {
+        T product = 1;
+        for (auto const &i: *this) {
+            product *= i;
+        }
+        return product;
+    }
+
+    template <typename T>
+    T fseq<T>::min() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty sequence";
+        return std::get<0>(this->minmax());
+    }
+
+    template <typename T>
+    T fseq<T>::max() const
+    {
+        if (this->empty()) throw "Cannot calculate the maximum of an empty sequence";
+        return std::get<1>(this->minmax());
+    }
+
+    template <typename T>
+    std::tuple<T,T> fseq<T>::minmax() const
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty sequence";
+
+        auto i = this->begin();
+        T min = *i;
+        T max = *i;
+        for (++i; i != this->end(); ++i) {
+            if (*i < min) min = *i;
+            if (max < *i) max = *i;
+        }
+        return std::make_tuple(min,max);
+    }
+
+    template <typename T>
+    void fseq<T>::foreach(std::function<void(T)> action) const
+    {
+        for (auto const &i: *this) {
+            action(i);
+        }
+    }
+
+    template <typename T>
+    template <typename U>
+    fseq<U> fseq<T>::select(std::function<U(T)> selector) const
+    {
+        std::vector<U> selected;
+        selected.reserve(this->size());
+        for (auto const &i: *this) {
+            selected.push_back(selector(i));
+        }
+        return fseq<U>(selected);
+    }
+
+    template <typename T>
+    std::uint32_t fseq<T>::next_priority()
+    {
+        // xorshift64*
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<std::uint32_t>((state * 0x2545f4914f6cdd1dULL) >> 32);
+    }
+
+    template <typename T>
+    typename fseq<T>::node *fseq<T>::build(const std::vector<T> &values, std::uint64_t &state)
+    {
+        if (values.empty()) return nullptr;
+
+        fseq<T> generator(static_cast<node *>(nullptr));
+        generator.state = state;
+
+        std::vector<node *> spine;
+        try {
+            for (auto const &i: values) {
+                node *n = new node(i,generator.next_priority());
+                node *last = nullptr;
+                while (!spine.empty() && spine.back()->priority < n->priority) {
+                    last = spine.back();
+                    spine.pop_back();
+                }
+                n->left = last;
+                if (!spine.empty()) spine.back()->right = n;
+                spine.push_back(n);
+            }
+        } catch (...) {
+            // every node built so far hangs from the bottom of the spine
+            node *first = spine.empty() ? nullptr : spine.front();
+            generator.root = first;
+            throw;
+        }
+
+        state = generator.state;
+        node *root = spine.front();
+        fix_sizes(root);
+        return root;
+    }
+
+    template <typename T>
+    inline std::size_t fseq<T>::size_of(const node *n) { return n ? n->size : 0; }
+
+    template <typename T>
+    inline void fseq<T>::update(node *n)
+    {
+        n->size = size_of(n->left) + size_of(n->right) + 1;
+    }
+
+    template <typename T>
+    std::size_t fseq<T>::fix_sizes(node *n)
+    {
+        if (n == nullptr) return 0;
+        n->size = fix_sizes(n->left) + fix_sizes(n->right) + 1;
+        return n->size;
+    }
+
+    template <typename T>
+    typename fseq<T>::node *fseq<T>::join(node *a, node *b)
+    {
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+
+        if (a->priority > b->priority) {
+            a->right = join(a->right,b);
+            update(a);
+            return a;
+        }
+        b->left = join(a,b->left);
+        update(b);
+        return b;
+    }
+
+    template <typename T>
+    void fseq<T>::split(node *n, std::size_t k, node *&a, node *&b)
+    {
+        if (n == nullptr) {
+            a = b = nullptr;
+            return;
+        }
+
+        // a takes the first k elements of n, b the others
+        if (size_of(n->left) < k) {
+            split(n->right,k - size_of(n->left) - 1,n->right,b);
+            a = n;
+        } else {
+            split(n->left,k,a,n->left);
+            b = n;
+        }
+        update(n);
+    }
+
+    template <typename T>
+    typename fseq<T>::node *fseq<T>::copy_of(const node *n)
+    {
+        if (n == nullptr) return nullptr;
+
+        node *c = new node(n->value,n->priority);
+        try {
+            c->left = copy_of(n->left);
+            c->right = copy_of(n->right);
+        } catch (...) {
+            destroy(c);
+            throw;
+        }
+        c->size = n->size;
+        return c;
+    }
+
+    template <typename T>
+    void fseq<T>::destroy(node *n)
+    {
+        while (n != nullptr) {
+            destroy(n->left);
+            node *right = n->right;
+            delete n;
+            n = right;
+        }
+    }
+}
@@ -0,0 +1,284 @@
+/*
+ *  collection/src/fseq.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fseq_h
+#define fseq_h
+
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <functional>
+#include <initializer_list>
+#include "algorithms.h"
+
+namespace fnc {
+
+    /*
+     * `fseq` is a sequence with O(log n) positional access and edits, on
+     * an implicit treap: a binary tree ordered by position, where every
+     * node stores the size of its subtree, balanced by random priorities.
+     *
+     *    at, set, insert_at, erase_at      O(log n)
+     *    split_at, concat, take, drop      O(log n) on a temporary fseq
+     *    push_front, push_back             O(log n)
+     *    scans and the functional operators O(n)
+     *
+     * Like for `flist`, the structural operators called on a temporary
+     * fseq reuse its nodes, while on an lvalue they work on a copy:
+     *
+     *     fseq<int> s = ...;
+     *     auto parts = std::move(s).split_at(10);    // O(log n)
+     */
+    template <typename T>
+    class fseq {
+
+        struct node;
+
+    public :
+        /*
+         * `const_iterator` visits the elements in order, keeping the path
+         * from the root on a stack.
+         */
+        class const_iterator {
+
+        public :
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T *pointer;
+            typedef const T &reference;
+
+            const_iterator() {}
+
+            inline reference operator*() const { return path.back()->value; }
+
+            inline pointer operator->() const { return &path.back()->value; }
+
+            const_iterator &operator++();
+
+            inline const_iterator operator++(int)
+            {
+                const_iterator old(*this);
+                ++(*this);
+                return old;
+            }
+
+            inline bool operator==(const const_iterator &other) const
+            {
+                return path.empty() ? other.path.empty()
+                                    : !other.path.empty() && path.back() == other.path.back();
+            }
+
+            inline bool operator!=(const const_iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private :
+            friend class fseq<T>;
+
+            std::vector<const node *> path;
+
+            void push_left(const node *n);
+        };
+
+        fseq();
+
+        fseq(std::initializer_list<T> l);
+
+        fseq(std::vector<T> v);
+
+        fseq(const fseq<T> &other);
+
+        fseq(fseq<T> &&other);
+
+        ~fseq();
+
+        fseq<T> &operator=(fseq<T> other);
+
+        inline std::size_t size() const;
+
+        inline bool empty() const;
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        std::vector<T> to_vector() const;
+
+        /*
+         * `at` returns the i-th element, in O(log n).
+         */
+        const T &at(std::size_t i) const;
+
+        /*
+         * `set` replaces the i-th element, in O(log n).
+         */
+        void set(std::size_t i, T value);
+
+        void push_front(T elem);
+
+        void push_back(T elem);
+
+        /*
+         * `insert_at` inserts `elem` before the i-th element (at the end
+         * if i == size), in O(log n).
+         */
+        void insert_at(std::size_t i, T elem);
+
+        /*
+         * `erase_at` removes the i-th element, in O(log n).
+         */
+        void erase_at(std::size_t i);
+
+        /*
+         * `concat` appends `other`, joining the two trees in O(log n): only
+         * the elements of this fseq are copied, and none of them if it is
+         * a temporary.
+         */
+        fseq<T> concat(fseq<T> other) &;
+        fseq<T> concat(fseq<T> other) &&;
+
+        /*
+         * `split_at` returns the tuple <take(i),drop(i)>, cutting the tree
+         * in O(log n) if the fseq is a temporary.
+         */
+        std::tuple<fseq<T>,fseq<T>> split_at(std::size_t i) &;
+        std::tuple<fseq<T>,fseq<T>> split_at(std::size_t i) &&;
+
+        /*
+         * `take` returns the first n elements of the fseq.
+         */
+        fseq<T> take(std::size_t n) &;
+        fseq<T> take(std::size_t n) &&;
+
+        /*
+         * `drop` drops the first n elements of the fseq.
+         */
+        fseq<T> drop(std::size_t n) &;
+        fseq<T> drop(std::size_t n) &&;
+
+        /*
+         * - f : a function;
+         * - base : a starting value (typically the right-identity of the
+         *          function;
+         * `foldr` reduces the fseq by applying `f` in a right-associative way
+         *
+         *     f(x1, f(x2, ... f(xn, base)))
+         */
+        T foldr(std::function<T(T,T)> f, T base) const;
+
+        /*
+         * - f : a function;
+         * - base : a starting value (typically the left-identity of the
+         *          function;
+         * `foldl` reduces the fseq by applying `f` in a left-associative way
+         *
+         *     f(... f(f(base, x1), x2) ..., xn)
+         */
+        T foldl(std::function<T(T,T)> f, T base) const;
+
+        /*
+         * `map` applies to each element of the fseq the function
+         *
+         *    f: T --> T
+         *
+         * and then returns the fseq of mapped elements.
+         */
+        fseq<T> map(std::function<T(T)> f) const;
+
+        /*
+         * `filter` returns an fseq with the elements that fullfill the
+         * predicate function
+         *
+         *    f: T --> bool
+         */
+        fseq<T> filter(std::function<bool(T)> predicate) const;
+
+        fseq<T> reverse() const;
+
+        bool any(T elem) const;
+
+        fseq<T> singleton(T element) const;
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        T sum() const;
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        T product() const;
+
+        /*
+         * `min` returns the minimum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T min() const;
+
+        /*
+         * `max` returns the maximum of the elements.
+         * WARNING: T must implement the operator (<)
+         */
+        T max() const;
+
+        /*
+         * `minmax` returns the tuple <min,max>.
+         */
+        std::tuple<T,T> minmax() const;
+
+        void foreach(std::function<void(T)> action) const;
+
+        template <typename U> fseq<U> select(std::function<U(T)> selector) const;
+
+    private :
+        template <typename U> friend class fseq;
+
+        struct node {
+            T value;
+            node *left;
+            node *right;
+            std::uint32_t priority;
+            std::size_t size;
+
+            node(T value, std::uint32_t priority)
+                : value(value), left(nullptr), right(nullptr), priority(priority), size(1) {}
+        };
+
+        node *root;
+        std::uint64_t state;
+
+        fseq(node *root);
+
+        std::uint32_t next_priority();
+
+        /*
+         * `build` makes a treap of `values` in O(n), as a Cartesian tree of
+         * random priorities built along its right spine.
+         */
+        static node *build(const std::vector<T> &values, std::uint64_t &state);
+
+        static inline std::size_t size_of(const node *n);
+        static inline void update(node *n);
+        static std::size_t fix_sizes(node *n);
+        static node *join(node *a, node *b);
+        static void split(node *n, std::size_t k, node *&a, node *&b);
+        static node *copy_of(const node *n);
+        static void destroy(node *n);
+    };
+
+}
+
+#include "fseq.cc"
+
+#endif
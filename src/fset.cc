@@ -7,164 +7,184 @@
  */
 
 #include <set>
-#include <map>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 
 namespace fnc {
 
-    template <typename T>
-    fset<T>::fset() : std::set<T>() {}
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend>::fset() : Backend<T>() {}
 
-    template <typename T>
-    fset<T>::fset(std::set<T> s) : std::set<T>(s) {}
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend>::fset(std::set<T> s) : Backend<T>(s.begin(),s.end()) {}
 
-    template <typename T>
-    inline std::set<T> fset<T>::to_set() { return *this; }
-
-    template <typename T>
-    fset<T> fset<T>::copy()
+    template <typename T, template <typename...> class Backend>
+    template <typename It>
+    fset<T,Backend> fset<T,Backend>::from_sorted(It first, It last)
     {
-        fset<T> new_set;
-        for (auto const &i: *this) {
-            new_set.insert(i);
+        fset<T,Backend> set;
+        for (; first != last; ++first) {
+            set.insert(set.end(),*first);
         }
-        return new_set;
+        return set;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    inline std::set<T> fset<T,Backend>::to_set()
+    {
+        return std::set<T>(this->begin(),this->end());
     }
 
-    template <typename T>
-    fset<T> fset<T>::map(std::function<T(T)> f)
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::copy() { return fset<T,Backend>(*this); }
+
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::map(std::function<T(T)> f)
     {
-        fset<T> set;
+        std::vector<T> mapped;
+        mapped.reserve(this->size());
         for (auto const &i: *this) {
-                set.insert(f(i));
+            mapped.push_back(f(i));
         }
-        return set;
+        std::sort(mapped.begin(),mapped.end());
+        return from_sorted(mapped.begin(),mapped.end());
     }
 
-    template <typename T>
-    fset<T> fset<T>::filter(std::function<bool(T)> predicate)
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::filter(std::function<bool(T)> predicate)
     {
-        fset<T> set;
+        // the elements come out already sorted: append them at the end
+        fset<T,Backend> set;
         for (auto const &i: *this) {
             if (predicate(i))
-                set.insert(i);
+                set.insert(set.end(),i);
         }
         return set;
     }
 
-    template <typename T>
-    fset<T> fset<T>::unite(fset<T> other)
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::unite(fset<T,Backend> other)
     {
-        std::map<T,bool> m;
-        fset<T> united;
-        for (auto const &i: *this) {
-            united.insert(i);
-            if (! map_contains(m,i)) m[i] = true;
-        }
-        for (auto const &j: other) {
-            if (! map_contains(m,j)) united.insert(j);
-        }
-
+        fset<T,Backend> united;
+        std::set_union(this->begin(),this->end(),other.begin(),other.end(),
+                       std::inserter(united,united.end()));
         return united;
     }
 
-    template <typename T>
-    fset<T> fset<T>::intersecate(fset<T> other)
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::intersecate(fset<T,Backend> other)
     {
-        std::map<T,bool> m;
-        fset<T> intersected;
+        fset<T,Backend> intersected;
+        std::set_intersection(this->begin(),this->end(),other.begin(),other.end(),
+                              std::inserter(intersected,intersected.end()));
+        return intersected;
+    }
+
+    template <typename T, template <typename...> class Backend>
+    template <typename S, typename H>
+    fset<T,Backend> fset<T,Backend>::intersecate(const S &other, const bloom<T,H> &filter)
+    {
+        fset<T,Backend> intersected;
         for (auto const &i: *this) {
-            if (! map_contains(m,i)) m[i] = true;
-        }
-        for (auto const &j: other) {
-            if (map_contains(m,j)) intersected.insert(j);
+            if (filter.possibly_contains(i) && other.find(i) != other.end())
+                intersected.insert(intersected.end(),i);
         }
 
         return intersected;
     }
 
-    template <typename T>
-    inline bool fset<T>::any(T elem) { return this->find(elem) != this->end(); }
-
-    template <typename T>
-    inline fset<T> fset<T>::singleton(T element) { return fset<T>({element}); }
+    template <typename T, template <typename...> class Backend>
+    inline bool fset<T,Backend>::any(T elem) { return this->find(elem) != this->end(); }
 
-    template <typename T>
-    T fset<T>::sum()
+    template <typename T, template <typename...> class Backend>
+    template <typename H>
+    inline bool fset<T,Backend>::any(T elem, const bloom<T,H> &filter)
     {
-        T sum = 0;
-
-        for (auto const &i: *this) {
-            sum += i;
-        }
-        return sum;
+        return filter.possibly_contains(elem) && this->find(elem) != this->end();
     }
 
-    template <typename T>
-    T fset<T>::product()
+    template <typename T, template <typename...> class Backend>
+    inline fset<T,Backend> fset<T,Backend>::singleton(T element) { return fset<T,Backend>({element}); }
+
+    template <typename T, template <typename...> class Backend>
+    T fset<T,Backend>::sum()
     {
-        T product = 1;
+        return accumulate_sum(*this,T(0));
+    }
 
-        for (auto const &i: *this) {
-            product *= i;
-        }
-        return product;
+    template <typename T, template <typename...> class Backend>
+    T fset<T,Backend>::product()
+    {
+        return accumulate_product(*this,T(1));
     }
 
-    template <typename T>
-    T fset<T>::min()
+    template <typename T, template <typename...> class Backend>
+    T fset<T,Backend>::min()
     {
-    
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+        return *this->begin();
     }
 
-    template <typename T>
-    T fset<T>::max()
+    template <typename T, template <typename...> class Backend>
+    T fset<T,Backend>::max()
     {
-        
+        if (this->empty()) throw "Cannot calculate the maximum of an empty set";
+        return *this->rbegin();
     }
 
-    template <typename T>
-    std::tuple<T,T> fset<T>::minmax()
+    template <typename T, template <typename...> class Backend>
+    std::tuple<T,T> fset<T,Backend>::minmax()
     {
-        
+        return std::make_tuple(this->min(),this->max());
     }
 
-    template <typename T>
-    void fset<T>::foreach(std::function<void(T)> action)
+    template <typename T, template <typename...> class Backend>
+    void fset<T,Backend>::foreach(std::function<void(T)> action)
     {
         for (auto const &i: *this) {
             action(i);
         }
     }
 
-    template <typename T>
-    template <typename U> fset<U> fset<T>::select(std::function<U(T)> selector)
+    template <typename T, template <typename...> class Backend>
+    template <typename U> fset<U,Backend> fset<T,Backend>::select(std::function<U(T)> selector)
     {
-        fset<U> res;
+        std::vector<U> selected;
+        selected.reserve(this->size());
         for (auto const &i: *this) {
-            res.insert(selector(i));
+            selected.push_back(selector(i));
         }
+        std::sort(selected.begin(),selected.end());
+        return fset<U,Backend>::from_sorted(selected.begin(),selected.end());
+    }
+
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::except(fset<T,Backend> other)
+    {
+        fset<T,Backend> res;
+        std::set_difference(this->begin(),this->end(),other.begin(),other.end(),
+                            std::inserter(res,res.end()));
         return res;
     }
 
-    template <typename T>
-    fset<T> fset<T>::except(fset<T> other)
+    template <typename T, template <typename...> class Backend>
+    template <typename S, typename H>
+    fset<T,Backend> fset<T,Backend>::except(const S &other, const bloom<T,H> &filter)
     {
-        std::map<T,bool> m;
-        fset<T> res;
-        for (auto const &i: other) {
-            if (! map_contains(m,i)) m[i] = true;
-        }
-        for (auto const &j: *this) {
-            if (!map_contains(m,j)) res.insert(j);
+        fset<T,Backend> res;
+        for (auto const &i: *this) {
+            if (!filter.possibly_contains(i) || other.find(i) == other.end())
+                res.insert(res.end(),i);
         }
 
         return res;
     }
 
-    template <typename T>
-    fset<T> fset<T>::intersperse(T elem)
+    template <typename T, template <typename...> class Backend>
+    fset<T,Backend> fset<T,Backend>::intersperse(T elem)
     {
-        fset<T> new_set;
+        fset<T,Backend> new_set;
         
         for (auto start = this->begin(), last = this->end()-1;
             start != this->end(); ++start) {
@@ -177,11 +197,4 @@ namespace fnc {
         
         return new_set;
     }
-
-    template <typename T>
-    template <typename U>
-    inline bool fset<T>::map_contains(std::map<T,U> m, T val)
-    {
-        return m.find(val) != m.end();
-    }
 }
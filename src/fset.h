@@ -10,23 +10,52 @@
 #define fset_h
 
 #include <set>
+#include "bloom.h"
+#include "algorithms.h"
+#include "pool_allocator.h"
+#include "mem_scope.h"
+
+/*
+ * The storage used by `fset` when no backend is given. Define it before
+ * including the library to change it for every fset, e.g.
+ *
+ *     #define FNC_SET_BACKEND fnc::pooled_set
+ *     #define FNC_SET_BACKEND fnc::tracked_set
+ */
+#ifndef FNC_SET_BACKEND
+#define FNC_SET_BACKEND std::set
+#endif
 
 namespace fnc {
 
-    template <typename T>
-    class fset : public std::set<T> {
+    /*
+     * `fset` is a functional set on top of an ordered set container,
+     * `Backend<T>`: std::set by default, or `pooled_set` to take its nodes
+     * from a `node_pool`.
+     */
+    template <typename T, template <typename...> class Backend = FNC_SET_BACKEND>
+    class fset : public Backend<T> {
     
     public :
         fset();
 
         fset(std::set<T> s);
 
+        /*
+         * `from_sorted` builds an fset from the sorted range [first,last)
+         * in linear time: every element is appended at the end of the
+         * tree with a hint, instead of being searched from the root.
+         * Duplicates are allowed and dropped.
+         */
+        template <typename It>
+        static fset<T,Backend> from_sorted(It first, It last);
+
         inline std::set<T> to_set();
 
         /*
          * `copy` returns a copy of the fset.
          */
-        fset<T> copy();
+        fset<T,Backend> copy();
 
         /*
          * `map` applies to each element of the fset the function
@@ -35,7 +64,7 @@ namespace fnc {
          *
          * and then returns the fset of mapped elements.
          */
-        fset<T> map(std::function<T(T)> f);
+        fset<T,Backend> map(std::function<T(T)> f);
 
         /*
          * `filter` returns an fset with the elements that fullfill the
@@ -43,15 +72,31 @@ namespace fnc {
          *
          *    f: T --> bool
          */
-        fset<T> filter(std::function<bool(T)> predicate);
+        fset<T,Backend> filter(std::function<bool(T)> predicate);
 
-        fset<T> unite(fset<T> other);
+        fset<T,Backend> unite(fset<T,Backend> other);
 
-        fset<T> intersecate(fset<T> other);
+        fset<T,Backend> intersecate(fset<T,Backend> other);
+
+        /*
+         * `intersecate` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this fset rejected by the filter skip the lookup in
+         * `other`, and the others are looked up in it directly.
+         */
+        template <typename S, typename H>
+        fset<T,Backend> intersecate(const S &other, const bloom<T,H> &filter);
 
         bool any(T elem);
 
-        fset<T> singleton(T element);
+        /*
+         * `any` with a bloom filter built from this fset: if the filter
+         * rejects `elem` the tree is not walked at all.
+         */
+        template <typename H>
+        bool any(T elem, const bloom<T,H> &filter);
+
+        fset<T,Backend> singleton(T element);
 
         /*
          * `sum` returns the sum of the elements.
@@ -66,34 +111,38 @@ namespace fnc {
         T product();
 
         /*
-         * `min` returns the minimum of the elements.
-         * WARNING: T must implement the operator (<=)
+         * `min` returns the minimum of the elements in O(1), reading it
+         * from the leftmost end of the tree.
          */
         T min();
 
         /*
-         * `min` returns the maximum of the elements.
-         * WARNING: T must implement the operator (>=)
+         * `max` returns the maximum of the elements in O(1), reading it
+         * from the rightmost end of the tree.
          */
         T max();
 
         /*
          * `minmax` returns the tuple <min,max>.
-         * WARNING: T must implement both (<=) and (>=)
          */
         std::tuple<T,T> minmax();
 
         void foreach(std::function<void(T)> action);
 
-        template <typename U> fset<U> select(std::function<U(T)> selector);
+        template <typename U> fset<U,Backend> select(std::function<U(T)> selector);
+
+        fset<T,Backend> except(fset<T,Backend> other);
 
-        fset<T> except(fset<T> other);
+        /*
+         * `except` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this fset rejected by the filter are kept without the
+         * lookup in `other`.
+         */
+        template <typename S, typename H>
+        fset<T,Backend> except(const S &other, const bloom<T,H> &filter);
 
-        fset<T> intersperse(T elem);
-        
-    private :
-        template <typename U>
-        inline bool map_contains(std::map<T,U> m, T val);
+        fset<T,Backend> intersperse(T elem);
     };
 
 }
@@ -0,0 +1,416 @@
+/*
+ *  collection/src/fset_os.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <set>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace fnc {
+
+    template <typename T>
+    fset_os<T>::fset_os() : root(nullptr), first(nullptr), last(nullptr) {}
+
+    template <typename T>
+    fset_os<T>::fset_os(std::set<T> s) : root(nullptr), first(nullptr), last(nullptr)
+    {
+        std::vector<T> values(s.begin(),s.end());
+        root = build(values,0,values.size());
+        refresh_ends();
+    }
+
+    template <typename T>
+    fset_os<T>::fset_os(const fset_os<T> &other)
+        : root(clone(other.root)), first(nullptr), last(nullptr)
+    {
+        refresh_ends();
+    }
+
+    template <typename T>
+    fset_os<T>::fset_os(fset_os<T> &&other)
+        : root(other.root), first(other.first), last(other.last)
+    {
+        other.root = other.first = other.last = nullptr;
+    }
+
+    template <typename T>
+    fset_os<T>::~fset_os() { destroy(root); }
+
+    template <typename T>
+    fset_os<T> &fset_os<T>::operator=(fset_os<T> other)
+    {
+        std::swap(root,other.root);
+        std::swap(first,other.first);
+        std::swap(last,other.last);
+        return *this;
+    }
+
+    template <typename T>
+    inline std::size_t fset_os<T>::size() const { return size_of(root); }
+
+    template <typename T>
+    inline bool fset_os<T>::empty() const { return root == nullptr; }
+
+    template <typename T>
+    bool fset_os<T>::insert(T elem)
+    {
+        node *inserted = nullptr;
+        root = insert_node(root,elem,inserted);
+        if (inserted == nullptr) return false;
+
+        if (first == nullptr || elem < first->value) first = inserted;
+        if (last == nullptr || last->value < elem) last = inserted;
+        return true;
+    }
+
+    template <typename T>
+    bool fset_os<T>::erase(T elem)
+    {
+        bool erased = false;
+        root = erase_node(root,elem,erased);
+        if (erased) refresh_ends();
+        return erased;
+    }
+
+    template <typename T>
+    void fset_os<T>::clear()
+    {
+        destroy(root);
+        root = first = last = nullptr;
+    }
+
+    template <typename T>
+    fset<T> fset_os<T>::to_set()
+    {
+        fset<T> set;
+        this->foreach([&set](T x) { set.insert(set.end(),x); });
+        return set;
+    }
+
+    template <typename T>
+    fset_os<T> fset_os<T>::copy() { return fset_os<T>(*this); }
+
+    template <typename T>
+    bool fset_os<T>::any(T elem)
+    {
+        node *n = root;
+        while (n != nullptr) {
+            if (elem < n->value)
+                n = n->left;
+            else if (n->value < elem)
+                n = n->right;
+            else
+                return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    T fset_os<T>::nth(std::size_t k)
+    {
+        if (k >= this->size()) throw "ERROR: index out of range";
+
+        node *n = root;
+        while (true) {
+            std::size_t left = size_of(n->left);
+            if (k < left) {
+                n = n->left;
+            } else if (k == left) {
+                return n->value;
+            } else {
+                k -= left + 1;
+                n = n->right;
+            }
+        }
+    }
+
+    template <typename T>
+    std::size_t fset_os<T>::rank(T elem)
+    {
+        std::size_t r = 0;
+        node *n = root;
+        while (n != nullptr) {
+            if (n->value < elem) {
+                r += size_of(n->left) + 1;
+                n = n->right;
+            } else {
+                n = n->left;
+            }
+        }
+        return r;
+    }
+
+    template <typename T>
+    std::size_t fset_os<T>::count_range(T lo, T hi)
+    {
+        if (hi < lo) return 0;
+
+        // number of elements <= hi
+        std::size_t upper = 0;
+        node *n = root;
+        while (n != nullptr) {
+            if (hi < n->value) {
+                n = n->left;
+            } else {
+                upper += size_of(n->left) + 1;
+                n = n->right;
+            }
+        }
+        return upper - this->rank(lo);
+    }
+
+    template <typename T>
+    T fset_os<T>::quantile(double q)
+    {
+        if (this->empty()) throw "Cannot calculate a quantile of an empty set";
+        if (q < 0 || q > 1) throw "q must be in the range [0,1]";
+
+        std::size_t k = static_cast<std::size_t>(std::ceil(q * this->size()));
+        return this->nth(k == 0 ? 0 : k-1);
+    }
+
+    template <typename T>
+    T fset_os<T>::min()
+    {
+        if (this->empty()) throw "Cannot calculate the minimum of an empty set";
+        return first->value;
+    }
+
+    template <typename T>
+    T fset_os<T>::max()
+    {
+        if (this->empty()) throw "Cannot calculate the maximum of an empty set";
+        return last->value;
+    }
+
+    template <typename T>
+    std::tuple<T,T> fset_os<T>::minmax()
+    {
+        return std::make_tuple(this->min(),this->max());
+    }
+
+    template <typename T>
+    fset_os<T> fset_os<T>::map(std::function<T(T)> f)
+    {
+        std::vector<T> values;
+        values.reserve(this->size());
+        this->foreach([&values,&f](T x) { values.push_back(f(x)); });
+        std::sort(values.begin(),values.end());
+        values.erase(std::unique(values.begin(),values.end(),
+                                 [](const T &x, const T &y) { return !(x < y) && !(y < x); }),
+                     values.end());
+
+        fset_os<T> set;
+        set.root = build(values,0,values.size());
+        set.refresh_ends();
+        return set;
+    }
+
+    template <typename T>
+    fset_os<T> fset_os<T>::filter(std::function<bool(T)> predicate)
+    {
+        std::vector<T> values;
+        this->foreach([&values,&predicate](T x) {
+            if (predicate(x))
+                values.push_back(x);
+        });
+
+        fset_os<T> set;
+        set.root = build(values,0,values.size());
+        set.refresh_ends();
+        return set;
+    }
+
+    template <typename T>
+    T fset_os<T>::sum()
+    {
+        T sum = 0;
+        this->foreach([&sum](T x) { sum += x; });
+        return sum;
+    }
+
+    template <typename T>
+    T fset_os<T>::product()
+    {
+        T product = 1;
+        this->foreach([&product](T x) { product *= x; });
+        return product;
+    }
+
+    template <typename T>
+    void fset_os<T>::foreach(std::function<void(T)> action)
+    {
+        visit(root,action);
+    }
+
+    template <typename T>
+    inline int fset_os<T>::height_of(node *n) { return n == nullptr ? 0 : n->height; }
+
+    template <typename T>
+    inline std::size_t fset_os<T>::size_of(node *n) { return n == nullptr ? 0 : n->size; }
+
+    template <typename T>
+    inline void fset_os<T>::update(node *n)
+    {
+        n->height = 1 + std::max(height_of(n->left),height_of(n->right));
+        n->size = 1 + size_of(n->left) + size_of(n->right);
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::rotate_left(node *n)
+    {
+        node *r = n->right;
+        n->right = r->left;
+        r->left = n;
+        update(n);
+        update(r);
+        return r;
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::rotate_right(node *n)
+    {
+        node *l = n->left;
+        n->left = l->right;
+        l->right = n;
+        update(n);
+        update(l);
+        return l;
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::rebalance(node *n)
+    {
+        update(n);
+        int balance = height_of(n->left) - height_of(n->right);
+
+        if (balance > 1) {
+            if (height_of(n->left->left) < height_of(n->left->right))
+                n->left = rotate_left(n->left);
+            return rotate_right(n);
+        }
+        if (balance < -1) {
+            if (height_of(n->right->right) < height_of(n->right->left))
+                n->right = rotate_right(n->right);
+            return rotate_left(n);
+        }
+        return n;
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::insert_node(node *n, T elem, node *&inserted)
+    {
+        if (n == nullptr) {
+            inserted = new node(elem);
+            return inserted;
+        }
+
+        if (elem < n->value)
+            n->left = insert_node(n->left,elem,inserted);
+        else if (n->value < elem)
+            n->right = insert_node(n->right,elem,inserted);
+        else
+            return n;
+
+        return rebalance(n);
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::detach_min(node *n, node *&min)
+    {
+        if (n->left == nullptr) {
+            min = n;
+            return n->right;
+        }
+        n->left = detach_min(n->left,min);
+        return rebalance(n);
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::erase_node(node *n, T elem, bool &erased)
+    {
+        if (n == nullptr) return nullptr;
+
+        if (elem < n->value) {
+            n->left = erase_node(n->left,elem,erased);
+        } else if (n->value < elem) {
+            n->right = erase_node(n->right,elem,erased);
+        } else {
+            erased = true;
+            node *left = n->left;
+            node *right = n->right;
+            delete n;
+
+            if (right == nullptr) return left;
+
+            node *successor = nullptr;
+            right = detach_min(right,successor);
+            successor->left = left;
+            successor->right = right;
+            return rebalance(successor);
+        }
+
+        return rebalance(n);
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::build(std::vector<T> &values,
+                                                   std::size_t lo, std::size_t hi)
+    {
+        if (lo >= hi) return nullptr;
+
+        std::size_t mid = lo + (hi - lo) / 2;
+        node *n = new node(values[mid]);
+        n->left = build(values,lo,mid);
+        n->right = build(values,mid+1,hi);
+        update(n);
+        return n;
+    }
+
+    template <typename T>
+    typename fset_os<T>::node *fset_os<T>::clone(node *n)
+    {
+        if (n == nullptr) return nullptr;
+
+        node *c = new node(n->value);
+        c->left = clone(n->left);
+        c->right = clone(n->right);
+        c->height = n->height;
+        c->size = n->size;
+        return c;
+    }
+
+    template <typename T>
+    void fset_os<T>::destroy(node *n)
+    {
+        if (n == nullptr) return;
+        destroy(n->left);
+        destroy(n->right);
+        delete n;
+    }
+
+    template <typename T>
+    void fset_os<T>::visit(node *n, std::function<void(T)> &action)
+    {
+        if (n == nullptr) return;
+        visit(n->left,action);
+        action(n->value);
+        visit(n->right,action);
+    }
+
+    template <typename T>
+    void fset_os<T>::refresh_ends()
+    {
+        first = last = root;
+        if (root == nullptr) return;
+        while (first->left != nullptr) first = first->left;
+        while (last->right != nullptr) last = last->right;
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ *  collection/src/fset_os.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fset_os_h
+#define fset_os_h
+
+#include <set>
+#include <tuple>
+#include <vector>
+#include <functional>
+#include "fset.h"
+
+namespace fnc {
+
+    /*
+     * `fset_os` is an order-statistics set: an AVL tree in which every node
+     * also stores the size of its subtree. On top of the usual membership
+     * operations it answers positional queries (`nth`, `rank`,
+     * `count_range`) in O(log n), while `min` and `max` are read in O(1)
+     * from the cached ends of the tree.
+     *
+     * Elements are ordered by the operator (<), exactly like `fset`.
+     */
+    template <typename T>
+    class fset_os {
+
+    public :
+        fset_os();
+
+        /*
+         * Builds the tree from an already sorted std::set in O(n).
+         */
+        fset_os(std::set<T> s);
+
+        fset_os(const fset_os<T> &other);
+
+        fset_os(fset_os<T> &&other);
+
+        ~fset_os();
+
+        fset_os<T> &operator=(fset_os<T> other);
+
+        inline std::size_t size() const;
+
+        inline bool empty() const;
+
+        /*
+         * `insert` adds `elem` to the set and returns false if it was
+         * already there.
+         */
+        bool insert(T elem);
+
+        /*
+         * `erase` removes `elem` from the set and returns false if it was
+         * not there.
+         */
+        bool erase(T elem);
+
+        void clear();
+
+        fset<T> to_set();
+
+        /*
+         * `copy` returns a copy of the fset_os.
+         */
+        fset_os<T> copy();
+
+        bool any(T elem);
+
+        /*
+         * `nth` returns the k-th smallest element (0-based).
+         */
+        T nth(std::size_t k);
+
+        /*
+         * `rank` returns the number of elements strictly less than `elem`.
+         */
+        std::size_t rank(T elem);
+
+        /*
+         * `count_range` returns the number of elements x such that
+         *
+         *    lo <= x <= hi
+         */
+        std::size_t count_range(T lo, T hi);
+
+        /*
+         * `quantile` returns the element at the nearest rank of `q`,
+         * with 0 <= q <= 1. For instance quantile(0.99) is the p99.
+         */
+        T quantile(double q);
+
+        /*
+         * `min` returns the minimum of the elements in O(1).
+         */
+        T min();
+
+        /*
+         * `max` returns the maximum of the elements in O(1).
+         */
+        T max();
+
+        /*
+         * `minmax` returns the tuple <min,max>.
+         */
+        std::tuple<T,T> minmax();
+
+        /*
+         * `map` applies to each element of the fset_os the function
+         *
+         *    f: T --> T
+         *
+         * and then returns the fset_os of mapped elements.
+         */
+        fset_os<T> map(std::function<T(T)> f);
+
+        /*
+         * `filter` returns an fset_os with the elements that fullfill the
+         * predicate function
+         *
+         *    f: T --> bool
+         */
+        fset_os<T> filter(std::function<bool(T)> predicate);
+
+        /*
+         * `sum` returns the sum of the elements.
+         * WARNING: T must implement the operator (+)
+         */
+        T sum();
+
+        /*
+         * `product` returns the product of the elements.
+         * WARNING: T must implement the operator (*)
+         */
+        T product();
+
+        /*
+         * `foreach` visits the elements in ascending order.
+         */
+        void foreach(std::function<void(T)> action);
+
+    private :
+        struct node {
+            T value;
+            node *left;
+            node *right;
+            int height;
+            std::size_t size;
+
+            node(T v) : value(v), left(nullptr), right(nullptr),
+                        height(1), size(1) {}
+        };
+
+        node *root;
+        node *first;
+        node *last;
+
+        static inline int height_of(node *n);
+        static inline std::size_t size_of(node *n);
+        static inline void update(node *n);
+        static node *rotate_left(node *n);
+        static node *rotate_right(node *n);
+        static node *rebalance(node *n);
+        static node *insert_node(node *n, T elem, node *&inserted);
+        static node *erase_node(node *n, T elem, bool &erased);
+        static node *detach_min(node *n, node *&min);
+        static node *build(std::vector<T> &values, std::size_t lo,
+                           std::size_t hi);
+        static node *clone(node *n);
+        static void destroy(node *n);
+        static void visit(node *n, std::function<void(T)> &action);
+        void refresh_ends();
+    };
+
+}
+
+#include "fset_os.cc"
+
+#endif
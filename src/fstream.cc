@@ -0,0 +1,288 @@
+/*
+ *  collection/src/fstream.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+
+namespace fnc {
+
+    template <typename T>
+    fstream<T>::fstream() : fstream([]() { return cons_ptr(); }) {}
+
+    template <typename T>
+    fstream<T>::fstream(std::function<cons_ptr()> thunk) : first(std::make_shared<cell>())
+    {
+        first->thunk = thunk;
+    }
+
+    template <typename T>
+    fstream<T>::~fstream()
+    {
+        // Release the cells retained only by this stream one by one:
+        // letting shared_ptr do it would recurse once per element. The
+        // conses are only const through cons_ptr, so moving out is safe.
+        std::shared_ptr<cell> p = std::move(first);
+        while (p && p.use_count() == 1) {
+            cons_ptr c = std::move(p->value);
+            p.reset();
+            if (!c || c.use_count() != 1) break;
+            p = std::move(const_cast<cons &>(*c).tail.first);
+        }
+    }
+
+    template <typename T>
+    fstream<T> &fstream<T>::operator=(fstream<T> other)
+    {
+        std::swap(first,other.first);
+        return *this;
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::cons_of(T elem, fstream<T> tail)
+    {
+        cons_ptr c = std::make_shared<cons>(elem,tail);
+        return fstream<T>([c]() { return c; });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::defer(std::function<fstream<T>()> f)
+    {
+        return fstream<T>([f]() { return f().force(); });
+    }
+
+    template <typename T>
+    typename fstream<T>::cons_ptr fstream<T>::force() const
+    {
+        cell &c = *first;
+        std::call_once(c.once,[&c]() {
+            c.value = c.thunk();
+            // drop what the thunk captured, e.g. the source of a `map`
+            c.thunk = nullptr;
+        });
+        return c.value;
+    }
+
+    template <typename T>
+    bool fstream<T>::empty() const { return this->force() == nullptr; }
+
+    template <typename T>
+    T fstream<T>::head() const
+    {
+        cons_ptr c = this->force();
+        if (c == nullptr) throw "ERROR: empty stream";
+        return c->head;
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::tail() const
+    {
+        cons_ptr c = this->force();
+        if (c == nullptr) throw "ERROR: empty stream";
+        return c->tail;
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::take(int n) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,n]() {
+            if (n <= 0) return cons_ptr();
+
+            cons_ptr c = source.force();
+            if (c == nullptr) return c;
+            return cons_ptr(std::make_shared<cons>(c->head,c->tail.take(n - 1)));
+        });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::drop(int n) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,n]() {
+            fstream<T> s(source);
+            for (int i = 0; i < n; ++i) {
+                cons_ptr c = s.force();
+                if (c == nullptr) return c;
+                s = c->tail;
+            }
+            return s.force();
+        });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::take_while(std::function<bool(T)> predicate) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,predicate]() {
+            cons_ptr c = source.force();
+            if (c == nullptr || !predicate(c->head)) return cons_ptr();
+            return cons_ptr(std::make_shared<cons>(c->head,c->tail.take_while(predicate)));
+        });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::drop_while(std::function<bool(T)> predicate) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,predicate]() {
+            fstream<T> s(source);
+            cons_ptr c = s.force();
+            while (c != nullptr && predicate(c->head)) {
+                s = c->tail;
+                c = s.force();
+            }
+            return c;
+        });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::map(std::function<T(T)> f) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,f]() {
+            cons_ptr c = source.force();
+            if (c == nullptr) return c;
+            return cons_ptr(std::make_shared<cons>(f(c->head),c->tail.map(f)));
+        });
+    }
+
+    template <typename T>
+    fstream<T> fstream<T>::filter(std::function<bool(T)> predicate) const
+    {
+        fstream<T> source(*this);
+        return fstream<T>([source,predicate]() {
+            fstream<T> s(source);
+            cons_ptr c = s.force();
+            while (c != nullptr && !predicate(c->head)) {
+                s = c->tail;
+                c = s.force();
+            }
+            if (c == nullptr) return c;
+            return cons_ptr(std::make_shared<cons>(c->head,c->tail.filter(predicate)));
+        });
+    }
+
+    template <typename T>
+    template <typename U>
+    fstream<std::tuple<T,U>> fstream<T>::zip(fstream<U> other) const
+    {
+        typedef typename fstream<std::tuple<T,U>>::cons pair_cons;
+
+        fstream<T> source(*this);
+        return fstream<std::tuple<T,U>>([source,other]() {
+            auto a = source.force();
+            auto b = other.force();
+            if (a == nullptr || b == nullptr) return std::shared_ptr<const pair_cons>();
+            return std::shared_ptr<const pair_cons>(std::make_shared<pair_cons>(
+                std::make_tuple(a->head,b->head),a->tail.zip(b->tail)));
+        });
+    }
+
+    template <typename T>
+    template <typename U, typename F>
+    fstream<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>(),
+                                                             std::declval<const U &>()))>::type>
+    fstream<T>::zip_with(fstream<U> other, F f) const
+    {
+        typedef typename std::decay<decltype(f(std::declval<const T &>(),std::declval<const U &>()))>::type R;
+        typedef typename fstream<R>::cons zipped_cons;
+
+        fstream<T> source(*this);
+        return fstream<R>([source,other,f]() {
+            auto a = source.force();
+            auto b = other.force();
+            if (a == nullptr || b == nullptr) return std::shared_ptr<const zipped_cons>();
+            return std::shared_ptr<const zipped_cons>(std::make_shared<zipped_cons>(
+                f(a->head,b->head),a->tail.zip_with(b->tail,f)));
+        });
+    }
+
+    template <typename T>
+    template <typename U>
+    fstream<U> fstream<T>::select(std::function<U(T)> selector) const
+    {
+        typedef typename fstream<U>::cons selected_cons;
+
+        fstream<T> source(*this);
+        return fstream<U>([source,selector]() {
+            auto c = source.force();
+            if (c == nullptr) return std::shared_ptr<const selected_cons>();
+            return std::shared_ptr<const selected_cons>(std::make_shared<selected_cons>(
+                selector(c->head),c->tail.select(selector)));
+        });
+    }
+
+    template <typename T>
+    flist<T> fstream<T>::to_flist() const
+    {
+        flist<T> list;
+        this->foreach([&list](T x) { list.push_back(x); });
+        return list;
+    }
+
+    template <typename T>
+    T fstream<T>::foldl(std::function<T(T,T)> f, T base) const
+    {
+        T acc = base;
+        this->foreach([&acc,&f](T x) { acc = f(acc,x); });
+        return acc;
+    }
+
+    template <typename T>
+    void fstream<T>::foreach(std::function<void(T)> action) const
+    {
+        fstream<T> s(*this);
+        for (cons_ptr c = s.force(); c != nullptr; c = s.force()) {
+            action(c->head);
+            s = c->tail;
+        }
+    }
+
+    template <typename T>
+    fstream<T> iterate(std::function<T(T)> f, T x)
+    {
+        return fstream<T>::cons_of(x,fstream<T>::defer([f,x]() { return iterate(f,f(x)); }));
+    }
+
+    template <typename T>
+    fstream<T> repeat(T x)
+    {
+        return fstream<T>::cons_of(x,fstream<T>::defer([x]() { return repeat(x); }));
+    }
+
+    template <typename T, typename S>
+    fstream<T> unfold(std::function<std::tuple<bool,T,S>(S)> f, S seed)
+    {
+        return fstream<T>::defer([f,seed]() {
+            std::tuple<bool,T,S> next = f(seed);
+            if (!std::get<0>(next)) return fstream<T>();
+            return fstream<T>::cons_of(std::get<1>(next),unfold(f,std::get<2>(next)));
+        });
+    }
+
+    /*
+     * `cycle_from` is the stream of the elements of `elems` from the i-th
+     * one on, starting over at the end.
+     */
+    template <typename T>
+    fstream<T> cycle_from(std::shared_ptr<const std::vector<T>> elems, std::size_t i)
+    {
+        return fstream<T>::cons_of((*elems)[i],fstream<T>::defer([elems,i]() {
+            return cycle_from(elems,(i + 1) % elems->size());
+        }));
+    }
+
+    template <typename C>
+    fstream<typename C::value_type> cycle(C container)
+    {
+        typedef typename C::value_type T;
+
+        auto elems = std::make_shared<const std::vector<T>>(container.begin(),container.end());
+        if (elems->empty()) return fstream<T>();
+        return cycle_from(elems,0);
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ *  collection/src/fstream.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef fstream_h
+#define fstream_h
+
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include "flist.h"
+
+namespace fnc {
+
+    /*
+     * `fstream` is a lazy, possibly infinite, list. Each element is
+     * computed the first time someone asks for it and then memoized: all
+     * the copies of a stream share the elements already computed, and so
+     * do the threads reading it.
+     *
+     * A stream only retains the elements from its head on: a copy moving
+     * forward frees the elements behind it, unless an earlier position of
+     * the stream is still retained somewhere else.
+     *
+     * The operators (`map`, `filter`, `take`, ...) are lazy as well, while
+     * `to_flist`, `foldl` and `foreach` walk the whole stream: call them on
+     * finite streams only.
+     *
+     * Example:
+     *
+     *     fstream<int> evens = iterate<int>([](int x) { return x + 2; }, 0);
+     *     flist<int> l = evens.map([](int x) { return x * x; }).take(5).to_flist();
+     */
+    template <typename T>
+    class fstream {
+
+        struct cons;
+
+    public :
+        /*
+         * The empty stream.
+         */
+        fstream();
+
+        fstream(const fstream<T> &other) = default;
+
+        fstream(fstream<T> &&other) = default;
+
+        ~fstream();
+
+        fstream<T> &operator=(fstream<T> other);
+
+        /*
+         * `cons_of` returns the stream made of `elem` followed by `tail`.
+         */
+        static fstream<T> cons_of(T elem, fstream<T> tail);
+
+        /*
+         * `defer` returns a stream that calls `f` to know what it is, the
+         * first time it is read.
+         */
+        static fstream<T> defer(std::function<fstream<T>()> f);
+
+        /*
+         * `empty` forces the head of the stream.
+         */
+        bool empty() const;
+
+        /*
+         * `head` returns the first element of the fstream.
+         */
+        T head() const;
+
+        /*
+         * `tail` returns the fstream with the first element dropped.
+         */
+        fstream<T> tail() const;
+
+        /*
+         * `take` returns the (lazy) stream of the first n elements.
+         */
+        fstream<T> take(int n) const;
+
+        /*
+         * `drop` returns the stream without the first n elements; they are
+         * skipped only when the result is read.
+         */
+        fstream<T> drop(int n) const;
+
+        fstream<T> take_while(std::function<bool(T)> predicate) const;
+
+        fstream<T> drop_while(std::function<bool(T)> predicate) const;
+
+        /*
+         * `map` applies to each element of the fstream the function
+         *
+         *    f: T --> T
+         *
+         * lazily, when the element is read.
+         */
+        fstream<T> map(std::function<T(T)> f) const;
+
+        /*
+         * `filter` returns the stream of the elements that fullfill the
+         * predicate function
+         *
+         *    f: T --> bool
+         *
+         * WARNING: reading a filtered infinite stream with no more elements
+         * fullfilling the predicate never ends.
+         */
+        fstream<T> filter(std::function<bool(T)> predicate) const;
+
+        /*
+         * `zip` returns the stream of the pairs of corresponding elements,
+         * as long as the shortest stream.
+         */
+        template <typename U> fstream<std::tuple<T,U>> zip(fstream<U> other) const;
+
+        /*
+         * `zip_with` returns the stream of f(x,y) for the corresponding
+         * elements x and y, with the type returned by `f`, as long as the
+         * shortest stream.
+         */
+        template <typename U, typename F>
+        fstream<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>(),
+                                                                 std::declval<const U &>()))>::type>
+        zip_with(fstream<U> other, F f) const;
+
+        template <typename U> fstream<U> select(std::function<U(T)> selector) const;
+
+        flist<T> to_flist() const;
+
+        T foldl(std::function<T(T,T)> f, T base) const;
+
+        void foreach(std::function<void(T)> action) const;
+
+    private :
+        template <typename U> friend class fstream;
+
+        /*
+         * `cell` is a memoized thunk: `value` is null for the empty stream.
+         */
+        struct cell {
+            std::once_flag once;
+            std::function<std::shared_ptr<const cons>()> thunk;
+            std::shared_ptr<const cons> value;
+        };
+
+        struct cons {
+            T head;
+            fstream<T> tail;
+
+            cons(T head, fstream<T> tail) : head(head), tail(tail) {}
+        };
+
+        typedef std::shared_ptr<const cons> cons_ptr;
+
+        std::shared_ptr<cell> first;
+
+        fstream(std::function<cons_ptr()> thunk);
+
+        cons_ptr force() const;
+    };
+
+    /*
+     * `iterate` returns the infinite stream x, f(x), f(f(x)), ...
+     */
+    template <typename T>
+    fstream<T> iterate(std::function<T(T)> f, T x);
+
+    /*
+     * `repeat` returns the infinite stream x, x, x, ...
+     */
+    template <typename T>
+    fstream<T> repeat(T x);
+
+    /*
+     * `unfold` builds a stream from a seed: `f` returns the tuple
+     * <true,elem,next seed>, or <false,_,_> to end the stream.
+     */
+    template <typename T, typename S>
+    fstream<T> unfold(std::function<std::tuple<bool,T,S>(S)> f, S seed);
+
+    /*
+     * `cycle` repeats the elements of `container` forever (the empty
+     * stream if it is empty). The elements are copied once.
+     */
+    template <typename C>
+    fstream<typename C::value_type> cycle(C container);
+
+}
+
+#include "fstream.cc"
+
+#endif
@@ -10,7 +10,6 @@
 #include <string>
 #include <algorithm>
 #include <random>
-#include <chrono>
 #include <map>
 #include <tuple>
 
@@ -50,13 +49,14 @@ namespace fnc {
     }
 
     template <typename T>
-    fvec<T>::fvec() : std::vector<T>() {}
+    fvec<T>::fvec() : backend() {}
 
     template <typename T>
-    fvec<T>::fvec(std::vector<T> v) : std::vector<T>(v) {}
+    fvec<T>::fvec(std::vector<T> v)
+        : backend(std::make_move_iterator(v.begin()),std::make_move_iterator(v.end())) {}
 
     template <typename T>
-    inline std::vector<T> fvec<T>::to_vector() { return *this; }
+    inline std::vector<T> fvec<T>::to_vector() { return std::vector<T>(this->begin(),this->end()); }
 
     template <typename T>
     inline T fvec<T>::head() { return this->front(); }
@@ -65,12 +65,7 @@ namespace fnc {
     fvec<T> fvec<T>::drop(int n)
     {
         fvec<T> vector;
-    
-        if (this->empty()) return vector;
-    
-        for (auto first = this->begin()+n; first != this->end(); ++first) {
-            vector.push_back(*first);
-        }
+        append_slice(vector,*this,std::max(n,0),this->size());
         return vector;
     }
 
@@ -95,12 +90,7 @@ namespace fnc {
     fvec<T> fvec<T>::take(int n)
     {
         fvec<T> new_vec;
-        int counter = 0;
-        for (auto const &i: *this) {
-            if (counter == n) break;
-            new_vec.push_back(i);
-            counter++;
-        }
+        append_slice(new_vec,*this,0,std::max(n,0));
         return new_vec;
     }
 
@@ -108,9 +98,7 @@ namespace fnc {
     fvec<T> fvec<T>::copy()
     {
         fvec<T> new_vec;
-        for (auto const &i: *this) {
-            new_vec.push_back(i);
-        }
+        append_all(new_vec,*this);
         return new_vec;
     }
 
@@ -132,24 +120,60 @@ namespace fnc {
     fvec<T> fvec<T>::scanr(std::function<T(T,T)> f, T base)
     {
         fvec<T> vec;
-        auto tails = this->tails();
-        for (fvec<T> &i: tails) {
-            vec.push_back(i.foldr(f,base));
+        vec.assign(this->size() + 1,base);
+        for (std::size_t i = this->size(); i > 0; --i) {
+            vec[i-1] = f((*this)[i-1],vec[i]);
         }
-        vec.push_back(base);
-    
         return vec;
     }
 
     template <typename T>
     fvec<T> fvec<T>::scanl(std::function<T(T,T)> f, T base)
     {
-        fvec<T> vec({base});
-        auto inits = this->inits();
-        for (fvec<T> &i: inits) {
-            vec.push_back(i.foldl(f,base));
+        fvec<T> vec;
+        vec.reserve(this->size() + 1);
+        vec.push_back(base);
+        for (auto const &i: *this) {
+            vec.push_back(f(vec.back(),i));
         }
-    
+        return vec;
+    }
+
+    template <typename T>
+    fvec<T> fvec<T>::scanl1(std::function<T(T,T)> f)
+    {
+        if (this->empty()) return fvec<T>();
+        return this->tail().scanl(f,this->head());
+    }
+
+    template <typename T>
+    fvec<T> fvec<T>::scanr1(std::function<T(T,T)> f)
+    {
+        if (this->empty()) return fvec<T>();
+        return this->init().scanr(f,this->last());
+    }
+
+    template <typename T>
+    template <typename Op>
+    fvec<T> fvec<T>::inclusive_scan(Op op)
+    {
+        fvec<T> vec;
+        if (this->empty()) return vec;
+
+        vec.assign(this->size(),this->front());
+        fnc::inclusive_scan(this->data(),vec.data(),this->size(),op);
+        return vec;
+    }
+
+    template <typename T>
+    template <typename Op>
+    fvec<T> fvec<T>::exclusive_scan(Op op, T init)
+    {
+        fvec<T> vec;
+        if (this->empty()) return vec;
+
+        vec.assign(this->size(),init);
+        fnc::exclusive_scan(this->data(),vec.data(),this->size(),init,op);
         return vec;
     }
 
@@ -205,9 +229,7 @@ namespace fnc {
     fvec<T> fvec<T>::map(std::function<T(T)> f)
     {
         fvec<T> vector;
-        for (auto const &i: *this) {
-            vector.push_back(f(i));
-        }
+        map_into(vector,*this,f);
         return vector;
     }
 
@@ -215,51 +237,33 @@ namespace fnc {
     fvec<T> fvec<T>::filter(std::function<bool(T)> predicate)
     {
         fvec<T> vector;
-        for (auto const &i: *this) {
-            if (predicate(i))
-                vector.push_back(i);
-        }
+        filter_into(vector,*this,predicate);
         return vector;
     }
 
     template <typename T>
-    fvec<fvec<T> > fvec<T>::zip(fvec<T> other)
+    template <typename U>
+    fvec<std::tuple<T,U> > fvec<T>::zip(const fvec<U> &other)
     {
-        fvec<fvec<T>> result;
-    
-        for (auto first = this->begin(), second = other.begin();
-             first != this->end() && second != other.end();
-             ++first,++second) {
-            fvec<T> tmp;
-            tmp.push_back(*first);
-            tmp.push_back(*second);
-            result.push_back(tmp);
-        }
-        return result;                    
+        return fnc::zip_with([](const T &x, const U &y) { return std::make_tuple(x,y); },*this,other);
     }
 
     template <typename T>
-    fvec<T> fvec<T>::zip_with(fvec<T> other, std::function<bool(T,T)> f)
+    template <typename U, typename F>
+    fvec<typename std::decay<decltype(std::declval<F &>()(std::declval<T &>(),
+                                                          std::declval<const U &>()))>::type>
+    fvec<T>::zip_with(const fvec<U> &other, F f)
     {
-        fvec<T> result;
-    
-        for (auto first = this->begin(), second = other.begin();
-             first != this->end() && second != other.end();
-             ++first,++second) {
-            result.push_back(f(*first,*second));
-        }
-    
-        return result;
+        return fnc::zip_with(f,*this,other);
     }
 
     template <typename T>
     fvec<T> fvec<T>::concat(fvec<T> other)
     {
-        fvec<T> vec(*this);
-        for (auto const &i: other) {
-            vec.push_back(i);
-        }
-    
+        fvec<T> vec;
+        vec.reserve(this->size() + other.size());
+        append_all(vec,*this);
+        append_all(vec,other);
         return vec;
     }
 
@@ -316,6 +320,68 @@ namespace fnc {
         return intersected;
     }
 
+    template <typename T>
+    template <typename S, typename H>
+    fvec<T> fvec<T>::intersecate(const S &other, const bloom<T,H> &filter)
+    {
+        fvec<T> intersected;
+        for (auto const &i: *this) {
+            if (filter.possibly_contains(i) && other.find(i) != other.end())
+                intersected.push_back(i);
+        }
+
+        return intersected;
+    }
+
+    template <typename T>
+    template <typename U, typename KA, typename KB>
+    fvec<std::tuple<T,U> > fvec<T>::join_on(const fvec<U> &other, KA key_a, KB key_b)
+    {
+        return this->join_on(other,key_a,key_b,[](const T &x, const U &y) {
+            return std::make_tuple(x,y);
+        });
+    }
+
+    template <typename T>
+    template <typename U, typename KA, typename KB, typename P>
+    fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                          std::declval<const U &>()))>::type>
+    fvec<T>::join_on(const fvec<U> &other, KA key_a, KB key_b, P project)
+    {
+        typedef typename std::decay<decltype(project(std::declval<const T &>(),
+                                                     std::declval<const U &>()))>::type R;
+
+        return hash_join<false,R>(*this,other,key_a,key_b,[&project](const T &x, const U *y) {
+            return project(x,*y);
+        });
+    }
+
+    template <typename T>
+    template <typename U, typename KA, typename KB, typename P>
+    fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                          std::declval<const U *>()))>::type>
+    fvec<T>::left_join_on(const fvec<U> &other, KA key_a, KB key_b, P project)
+    {
+        typedef typename std::decay<decltype(project(std::declval<const T &>(),
+                                                     std::declval<const U *>()))>::type R;
+
+        return hash_join<true,R>(*this,other,key_a,key_b,project);
+    }
+
+    template <typename T>
+    template <typename U, typename KA, typename KB>
+    fvec<T> fvec<T>::semi_join_on(const fvec<U> &other, KA key_a, KB key_b)
+    {
+        return hash_semi_join(*this,other,key_a,key_b,true);
+    }
+
+    template <typename T>
+    template <typename U, typename KA, typename KB>
+    fvec<T> fvec<T>::anti_join_on(const fvec<U> &other, KA key_a, KB key_b)
+    {
+        return hash_semi_join(*this,other,key_a,key_b,false);
+    }
+
     template <typename T>
     fvec<T> fvec<T>::distinct()
     {
@@ -331,7 +397,17 @@ namespace fnc {
     }
 
     template <typename T>
-    inline bool fvec<T>::any(T elem) { return this->find(elem) != this->end(); }
+    inline bool fvec<T>::any(T elem)
+    {
+        return std::find(this->begin(),this->end(),elem) != this->end();
+    }
+
+    template <typename T>
+    template <typename H>
+    inline bool fvec<T>::any(T elem, const bloom<T,H> &filter)
+    {
+        return filter.possibly_contains(elem) && this->any(elem);
+    }
 
     template <typename T>
     inline fvec<T> fvec<T>::singleton(T element) { return fvec<T>({element}); }
@@ -342,32 +418,20 @@ namespace fnc {
         if (this->size() <= 1) return *this;
 
         fvec<T> vec;
-        for (auto i = this->end(); i != this->begin(); --i) {
-            vec.push_back(*i);
-        }
+        append_reversed(vec,*this);
         return vec;
     }
 
     template <typename T>
     T fvec<T>::sum()
     {
-        T sum = 0;
-
-        for (auto const &i: *this) {
-            sum += i;
-        }
-        return sum;
+        return accumulate_sum(*this,T(0));
     }
 
     template <typename T>
     T fvec<T>::product()
     {
-        T product = 1;
-
-        for (auto const &i: *this) {
-            product *= i;
-        }
-        return product;
+        return accumulate_product(*this,T(1));
     }
 
     template <typename T>
@@ -405,9 +469,7 @@ namespace fnc {
     fvec<U> fvec<T>::select(std::function<U(T)> selector)
     {
         fvec<U> res;
-        for (auto const &i: *this) {
-            res.push_back(selector(i));
-        }
+        map_into(res,*this,selector);
         return res;
     }
 
@@ -427,17 +489,32 @@ namespace fnc {
     }
 
     template <typename T>
-    fvec<T> fvec<T>::sort(std::function<bool(T,T)> comparator)
+    template <typename S, typename H>
+    fvec<T> fvec<T>::except(const S &other, const bloom<T,H> &filter)
+    {
+        fvec<T> res;
+        for (auto const &i: *this) {
+            if (!filter.possibly_contains(i) || other.find(i) == other.end())
+                res.push_back(i);
+        }
+
+        return res;
+    }
+
+    template <typename T>
+    sorted_fvec<T,std::function<bool(T,T)> > fvec<T>::sort(std::function<bool(T,T)> comparator)
     {
         fvec<T> sorted(*this);
         std::sort(sorted.begin(),sorted.end(),comparator);
-        return sorted;
+        return sorted_fvec<T,std::function<bool(T,T)> >::assume_sorted(std::move(sorted),comparator);
     }
 
     template <typename T>
-    fvec<T> fvec<T>::sort()
+    sorted_fvec<T> fvec<T>::sort()
     {
-        return this->sort([](T x,T y) { return x <= y; });
+        fvec<T> sorted(*this);
+        std::sort(sorted.begin(),sorted.end());
+        return sorted_fvec<T>::assume_sorted(std::move(sorted));
     }
 
     template <typename T>
@@ -474,7 +551,7 @@ namespace fnc {
     template <typename T>
     fvec<T> fvec<T>::rotate_left(int n_positions)
     {
-        std::vector<T> new_vec(*this);
+        fvec<T> new_vec(*this);
         std::rotate(new_vec.begin(),new_vec.begin()+n_positions,new_vec.end());
 
         return new_vec;
@@ -484,17 +561,34 @@ namespace fnc {
     fvec<T> fvec<T>::shuffle()
     {
         fvec<T> new_vec(*this);
+        shuffle_range(new_vec.begin(),new_vec.end(),thread_rng());
+        return new_vec;
+    }
 
-        auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-
-        shuffle (new_vec.begin(), new_vec.end(), std::default_random_engine(seed));
-    
+    template <typename T>
+    fvec<T> fvec<T>::shuffle(std::uint64_t seed)
+    {
+        fvec<T> new_vec(*this);
+        parallel_shuffle(new_vec,seed);
         return new_vec;
     }
 
+    template <typename T>
+    fvec<T> fvec<T>::sample(std::size_t k)
+    {
+        return fnc::sample(*this,k,thread_rng());
+    }
+
+    template <typename T>
+    fvec<T> fvec<T>::sample(std::size_t k, std::uint64_t seed)
+    {
+        xoshiro256 rng(seed);
+        return fnc::sample(*this,k,rng);
+    }
+
     template <typename T>
     template <typename U>
-    inline bool fvec<T>::map_contains(std::map<T,U> m, T val)
+    inline bool fvec<T>::map_contains(const std::map<T,U> &m, T val)
     {
         return m.find(val) != m.end();
     }
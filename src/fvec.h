@@ -12,13 +12,36 @@
 #include <vector>
 #include <map>
 #include <tuple>
+#include <functional>
+#include "bloom.h"
+#include "algorithms.h"
+#include "scan.h"
+#include "join.h"
+#include "zip.h"
+#include "random.h"
+#include "mem_scope.h"
+
+/*
+ * The allocator used by `fvec`. Define it before including the library
+ * to change it for every fvec, e.g.
+ *
+ *     #define FNC_VEC_ALLOCATOR fnc::tracking_allocator
+ */
+#ifndef FNC_VEC_ALLOCATOR
+#define FNC_VEC_ALLOCATOR std::allocator
+#endif
 
 namespace fnc {
 
+    template <typename T, typename Cmp = std::less<T> >
+    class sorted_fvec;
+
     template <typename T>
-    class fvec : public std::vector<T> {
+    class fvec : public std::vector<T,FNC_VEC_ALLOCATOR<T> > {
     
     public :
+        typedef std::vector<T,FNC_VEC_ALLOCATOR<T> > backend;
+
         fvec();
         
         fvec(std::vector<T> v);
@@ -104,10 +127,40 @@ namespace fnc {
          */
         T foldl(std::function<T(T,T)> f, T base);
 
+        /*
+         * `scanl` returns the fvec of the successive left folds:
+         *
+         *     scanl(f,base) = {base, f(base,x1), f(f(base,x1),x2), ...}
+         *
+         * and `scanr` the right folds, ending with base. `scanl1` and
+         * `scanr1` start from the first (last) element instead of a base.
+         * They take linear time, and call `f` in order.
+         */
         fvec<T> scanr(std::function<T(T,T)> f, T base);
 
         fvec<T> scanl(std::function<T(T,T)> f, T base);
 
+        fvec<T> scanl1(std::function<T(T,T)> f);
+
+        fvec<T> scanr1(std::function<T(T,T)> f);
+
+        /*
+         * `inclusive_scan` returns the running folds with the associative
+         * operator `op`, {x1, op(x1,x2), op(op(x1,x2),x3), ...}, and
+         * `exclusive_scan` the ones before each element, starting from
+         * `init`. They run in parallel on long fvecs, with SIMD kernels for
+         * std::plus, minimum and maximum: see `scan_from`.
+         *
+         * Example:
+         *
+         *     fvec<double> totals = prices.inclusive_scan(std::plus<double>());
+         */
+        template <typename Op>
+        fvec<T> inclusive_scan(Op op);
+
+        template <typename Op>
+        fvec<T> exclusive_scan(Op op, T init);
+
 
         /*
          * `group` returns an fvec of fvec, grouped by the predicate `f`
@@ -145,16 +198,22 @@ namespace fnc {
         fvec<T> filter(std::function<bool(T)> predicate);
 
         /*
-         * `zip` takes two lists and returns an fvec of corresponding pairs. 
-         * The length of the fvec is equal to the length of the shortest fvec.
+         * `zip` takes two fvecs and returns an fvec of corresponding pairs,
+         * as tuples. The length of the fvec is equal to the length of the
+         * shortest fvec. To walk the pairs without copying them, or to zip
+         * more than two containers, see the free function `zip`.
          */
-        fvec<fvec<T> > zip(fvec<T> other);
+        template <typename U>
+        fvec<std::tuple<T,U> > zip(const fvec<U> &other);
 
         /*
-         * `zip_with` does the same as `zip`, but you have to specify the
-         * comparator function (recommended for custom objects)
+         * `zip_with` returns the fvec of f(x,y) for the corresponding
+         * elements x and y, with the type returned by `f`.
          */
-        fvec<T> zip_with(fvec<T> other, std::function<bool(T,T)> f);
+        template <typename U, typename F>
+        fvec<typename std::decay<decltype(std::declval<F &>()(std::declval<T &>(),
+                                                              std::declval<const U &>()))>::type>
+        zip_with(const fvec<U> &other, F f);
 
         fvec<T> concat(fvec<T> other);
 
@@ -166,10 +225,76 @@ namespace fnc {
 
         fvec<T> intersecate(fvec<T> other);
 
+        /*
+         * `intersecate` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this fvec rejected by the filter skip the lookup in
+         * `other`, and the others are looked up in it directly.
+         */
+        template <typename S, typename H>
+        fvec<T> intersecate(const S &other, const bloom<T,H> &filter);
+
+        /*
+         * `join_on` is the inner join of this fvec with `other` on
+         * key_a(x) == key_b(y): it returns the tuple <x,y>, or project(x,y),
+         * for each pair of matching elements. The results come in the order
+         * of this fvec and, for the same x, in the order of `other`,
+         * whichever fvec is smaller. The hash table is built on the smaller
+         * fvec and probed from the larger one, in parallel on long fvecs:
+         * see `hash_join`.
+         *
+         * Example:
+         *
+         *     auto enriched = events.join_on(users,
+         *                                    [](const event &e) { return e.user_id; },
+         *                                    [](const user &u) { return u.id; },
+         *                                    [](const event &e, const user &u) {
+         *                                        return enrich(e,u);
+         *                                    });
+         *
+         * WARNING: the keys must implement the operator (==) and std::hash;
+         * on long fvecs the selectors and `project` are called concurrently.
+         */
+        template <typename U, typename KA, typename KB>
+        fvec<std::tuple<T,U> > join_on(const fvec<U> &other, KA key_a, KB key_b);
+
+        template <typename U, typename KA, typename KB, typename P>
+        fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                              std::declval<const U &>()))>::type>
+        join_on(const fvec<U> &other, KA key_a, KB key_b, P project);
+
+        /*
+         * `left_join_on` also keeps the elements of this fvec with no
+         * match: project(x,y) receives a pointer to y, null for them, and
+         * their results stay in place in the order of this fvec.
+         */
+        template <typename U, typename KA, typename KB, typename P>
+        fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                              std::declval<const U *>()))>::type>
+        left_join_on(const fvec<U> &other, KA key_a, KB key_b, P project);
+
+        /*
+         * `semi_join_on` returns the elements of this fvec whose key
+         * matches some element of `other`, and `anti_join_on` the others,
+         * in order.
+         */
+        template <typename U, typename KA, typename KB>
+        fvec<T> semi_join_on(const fvec<U> &other, KA key_a, KB key_b);
+
+        template <typename U, typename KA, typename KB>
+        fvec<T> anti_join_on(const fvec<U> &other, KA key_a, KB key_b);
+
         fvec<T> distinct();
 
         inline bool any(T elem);
 
+        /*
+         * `any` with a bloom filter built from this fvec: if the filter
+         * rejects `elem` the fvec is not scanned at all.
+         */
+        template <typename H>
+        inline bool any(T elem, const bloom<T,H> &filter);
+
         inline fvec<T> singleton(T element);
 
         fvec<T> reverse();
@@ -210,9 +335,24 @@ namespace fnc {
 
         fvec<T> except(fvec<T> other);
 
-        fvec<T> sort(std::function<bool(T,T)> comparator);
+        /*
+         * `except` with a set `other` (an fset, a std::set, a
+         * std::unordered_set...) and a bloom filter built from it: the
+         * elements of this fvec rejected by the filter are kept without the
+         * lookup in `other`.
+         */
+        template <typename S, typename H>
+        fvec<T> except(const S &other, const bloom<T,H> &filter);
 
-        fvec<T> sort();
+        /*
+         * `sort` returns the sorted fvec as a `sorted_fvec`, so that the
+         * set operations and joins on the result can merge instead of
+         * hashing. Without a comparator it sorts by (<).
+         * WARNING: `comparator` must be a strict weak ordering.
+         */
+        sorted_fvec<T,std::function<bool(T,T)> > sort(std::function<bool(T,T)> comparator);
+
+        sorted_fvec<T> sort();
 
         fvec<T> sort_heap(std::function<bool(T,T)> comparator);
 
@@ -222,11 +362,26 @@ namespace fnc {
 
         fvec<T> rotate_left(int n_positions);
 
+        /*
+         * `shuffle` returns the elements in random order. Without a seed
+         * it draws from `thread_rng`; with a seed the order is reproducible,
+         * and long fvecs are shuffled in parallel: see `parallel_shuffle`.
+         */
         fvec<T> shuffle();
+
+        fvec<T> shuffle(std::uint64_t seed);
+
+        /*
+         * `sample` returns k distinct elements chosen uniformly at random,
+         * in the order of the fvec: see the free function `sample`.
+         */
+        fvec<T> sample(std::size_t k);
+
+        fvec<T> sample(std::size_t k, std::uint64_t seed);
     
     private :
         template <typename U>
-        inline bool map_contains(std::map<T,U> m, T val);
+        inline bool map_contains(const std::map<T,U> &m, T val);
     };
 
     fvec<int> vrange(int start, int stop, int step);
@@ -235,5 +390,6 @@ namespace fnc {
 }
 
 #include "fvec.cc"
+#include "sorted_fvec.h"
 
 #endif
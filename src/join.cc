@@ -0,0 +1,276 @@
+/*
+ *  collection/src/join.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename K, typename Hash>
+    const std::size_t join_table<K,Hash>::none;
+
+    template <typename K, typename Hash>
+    join_table<K,Hash>::join_table(std::vector<K> keys)
+        : keys(std::move(keys)), partition_bits(0)
+    {
+        std::size_t n = this->keys.size();
+        std::size_t threads = scheduler::instance().concurrency();
+        bool parallel = threads > 1 && n >= 2 * FNC_PARALLEL_JOIN_THRESHOLD;
+        if (parallel) {
+            while ((static_cast<std::size_t>(1) << partition_bits) < 4 * threads) {
+                partition_bits++;
+            }
+        }
+        std::size_t parts = static_cast<std::size_t>(1) << partition_bits;
+
+        hashes.resize(n);
+        next.assign(n,none);
+        parallel_for(0,n,[this](std::size_t i) {
+            hashes[i] = this->hash_of(this->keys[i]);
+        },parallel ? FNC_PARALLEL_JOIN_THRESHOLD : n);
+
+        // counting sort of the positions by partition, keeping them in
+        // increasing order within each partition
+        std::vector<std::size_t> starts(parts + 1,0);
+        for (std::size_t i = 0; i < n; ++i) {
+            starts[(partition_bits ? hashes[i] >> (64 - partition_bits) : 0) + 1]++;
+        }
+        for (std::size_t p = 0; p < parts; ++p) {
+            starts[p+1] += starts[p];
+        }
+        std::vector<std::size_t> order(n);
+        std::vector<std::size_t> fill(starts.begin(),starts.end() - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            order[fill[partition_bits ? hashes[i] >> (64 - partition_bits) : 0]++] = i;
+        }
+
+        heads.resize(parts);
+        parallel_for(0,parts,[this,&starts,&order](std::size_t p) {
+            std::size_t buckets = 1;
+            while (buckets < 2 * (starts[p+1] - starts[p])) {
+                buckets <<= 1;
+            }
+            heads[p].assign(buckets,none);
+
+            // push the positions from the last one, so that every chain
+            // lists them in increasing order
+            for (std::size_t k = starts[p+1]; k > starts[p]; --k) {
+                std::size_t i = order[k-1];
+                std::size_t b = hashes[i] & (buckets - 1);
+                next[i] = heads[p][b];
+                heads[p][b] = i;
+            }
+        },1);
+    }
+
+    template <typename K, typename Hash>
+    inline std::size_t join_table<K,Hash>::size() const { return keys.size(); }
+
+    template <typename K, typename Hash>
+    template <typename F>
+    bool join_table<K,Hash>::probe(const K &key, F f) const
+    {
+        std::uint64_t h = this->hash_of(key);
+        const std::vector<std::size_t> &buckets = this->buckets_of(h);
+
+        bool found = false;
+        for (std::size_t i = buckets[h & (buckets.size() - 1)]; i != none; i = next[i]) {
+            if (hashes[i] == h && keys[i] == key) {
+                found = true;
+                f(i);
+            }
+        }
+        return found;
+    }
+
+    template <typename K, typename Hash>
+    bool join_table<K,Hash>::contains(const K &key) const
+    {
+        std::uint64_t h = this->hash_of(key);
+        const std::vector<std::size_t> &buckets = this->buckets_of(h);
+
+        for (std::size_t i = buckets[h & (buckets.size() - 1)]; i != none; i = next[i]) {
+            if (hashes[i] == h && keys[i] == key) return true;
+        }
+        return false;
+    }
+
+    template <typename K, typename Hash>
+    inline std::uint64_t join_table<K,Hash>::hash_of(const K &key) const
+    {
+        // std::hash is often the identity: mix it, the low bits pick the
+        // bucket and the high ones the partition
+        return mix64(static_cast<std::uint64_t>(hasher(key)));
+    }
+
+    template <typename K, typename Hash>
+    inline const std::vector<std::size_t> &join_table<K,Hash>::buckets_of(std::uint64_t h) const
+    {
+        return heads[partition_bits ? h >> (64 - partition_bits) : 0];
+    }
+
+    template <typename K, typename T, typename Key>
+    std::vector<K> keys_of(const fvec<T> &vec, Key &key)
+    {
+        std::vector<K> keys;
+        keys.reserve(vec.size());
+        for (auto const &i: vec) {
+            keys.push_back(key(i));
+        }
+        return keys;
+    }
+
+    /*
+     * `probe_in_chunks` calls f(first,last,out) on consecutive chunks of
+     * [0,n), in parallel if n is large, and returns the concatenation of
+     * the outputs, of type C (an fvec or a std::vector).
+     */
+    template <typename C, typename F>
+    C probe_in_chunks(std::size_t n, F f)
+    {
+        std::size_t threads = scheduler::instance().concurrency();
+        std::size_t chunks = threads > 1 ? std::min(4 * threads,n / FNC_PARALLEL_JOIN_THRESHOLD) : 0;
+        if (chunks < 2) {
+            C out;
+            f(static_cast<std::size_t>(0),n,out);
+            return out;
+        }
+
+        std::vector<C> parts(chunks);
+        std::size_t chunk = (n + chunks - 1) / chunks;
+        parallel_for(0,chunks,[&parts,&f,n,chunk](std::size_t c) {
+            std::size_t first = c * chunk;
+            f(first,std::min(n,first + chunk),parts[c]);
+        },1);
+
+        std::size_t total = 0;
+        for (auto const &p: parts) {
+            total += p.size();
+        }
+        C out;
+        out.reserve(total);
+        for (auto &p: parts) {
+            out.insert(out.end(),std::make_move_iterator(p.begin()),std::make_move_iterator(p.end()));
+        }
+        return out;
+    }
+
+    /*
+     * `push_unmatched` appends project(x,nullptr) for a left join, and is
+     * a no-op for an inner join, whose `project` may not take a null.
+     */
+    template <typename R, typename T, typename U, typename P>
+    inline void push_unmatched(fvec<R> &out, P &project, const T &x, const U *, std::true_type)
+    {
+        out.push_back(project(x,static_cast<const U *>(nullptr)));
+    }
+
+    template <typename R, typename T, typename U, typename P>
+    inline void push_unmatched(fvec<R> &, P &, const T &, const U *, std::false_type) {}
+
+    template <bool keep_unmatched, typename R, typename T, typename U, typename KA, typename KB, typename P>
+    fvec<R> hash_join(const fvec<T> &left, const fvec<U> &right, KA key_a, KB key_b, P project)
+    {
+        typedef std::integral_constant<bool,keep_unmatched> unmatched;
+
+        typedef typename std::decay<decltype(key_a(std::declval<const T &>()))>::type K;
+
+        if (right.size() <= left.size()) {
+            join_table<K> table(keys_of<K>(right,key_b));
+            return probe_in_chunks<fvec<R>>(left.size(),[&](std::size_t first, std::size_t last, fvec<R> &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const T &x = left[i];
+                    bool found = table.probe(key_a(x),[&](std::size_t j) {
+                        out.push_back(project(x,&right[j]));
+                    });
+                    if (!found)
+                        push_unmatched(out,project,x,static_cast<const U *>(nullptr),unmatched());
+                }
+            });
+        }
+
+        // `left` is the smaller side: probe from `right` collecting the
+        // matching (left, right) positions, then group them by left
+        // position so that the result comes in the order of `left` anyway
+        join_table<K> table(keys_of<K>(left,key_a));
+        typedef std::pair<std::size_t,std::size_t> match;
+        std::vector<match> pairs = probe_in_chunks<std::vector<match>>(right.size(),[&](std::size_t first, std::size_t last, std::vector<match> &out) {
+            for (std::size_t i = first; i < last; ++i) {
+                table.probe(key_b(right[i]),[&](std::size_t j) {
+                    out.push_back(match(j,i));
+                });
+            }
+        });
+
+        // counting sort by left position, stable so that the matches of
+        // each element of `left` stay in the order of `right`
+        std::vector<std::size_t> starts(left.size() + 1,0);
+        for (auto const &p: pairs) {
+            ++starts[p.first + 1];
+        }
+        for (std::size_t j = 0; j < left.size(); ++j) {
+            starts[j + 1] += starts[j];
+        }
+        std::vector<std::size_t> matches(pairs.size());
+        {
+            std::vector<std::size_t> at(starts.begin(),starts.end() - 1);
+            for (auto const &p: pairs) {
+                matches[at[p.first]++] = p.second;
+            }
+        }
+
+        return probe_in_chunks<fvec<R>>(left.size(),[&](std::size_t first, std::size_t last, fvec<R> &out) {
+            for (std::size_t j = first; j < last; ++j) {
+                const T &x = left[j];
+                if (starts[j] == starts[j + 1])
+                    push_unmatched(out,project,x,static_cast<const U *>(nullptr),unmatched());
+                for (std::size_t k = starts[j]; k < starts[j + 1]; ++k) {
+                    out.push_back(project(x,&right[matches[k]]));
+                }
+            }
+        });
+    }
+
+    template <typename T, typename U, typename KA, typename KB>
+    fvec<T> hash_semi_join(const fvec<T> &left, const fvec<U> &right, KA key_a, KB key_b,
+                           bool keep_matched)
+    {
+        typedef typename std::decay<decltype(key_a(std::declval<const T &>()))>::type K;
+
+        if (right.size() <= left.size()) {
+            join_table<K> table(keys_of<K>(right,key_b));
+            return probe_in_chunks<fvec<T>>(left.size(),[&](std::size_t first, std::size_t last, fvec<T> &out) {
+                for (std::size_t i = first; i < last; ++i) {
+                    if (table.contains(key_a(left[i])) == keep_matched)
+                        out.push_back(left[i]);
+                }
+            });
+        }
+
+        join_table<K> table(keys_of<K>(left,key_a));
+        std::unique_ptr<std::atomic<bool>[]> matched(new std::atomic<bool>[left.size()]);
+        for (std::size_t j = 0; j < left.size(); ++j) {
+            matched[j].store(false,std::memory_order_relaxed);
+        }
+        probe_in_chunks<std::vector<char>>(right.size(),[&](std::size_t first, std::size_t last, std::vector<char> &) {
+            for (std::size_t i = first; i < last; ++i) {
+                table.probe(key_b(right[i]),[&](std::size_t j) {
+                    matched[j].store(true,std::memory_order_relaxed);
+                });
+            }
+        });
+
+        fvec<T> out;
+        for (std::size_t j = 0; j < left.size(); ++j) {
+            if (matched[j].load(std::memory_order_relaxed) == keep_matched)
+                out.push_back(left[j]);
+        }
+        return out;
+    }
+}
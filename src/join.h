@@ -0,0 +1,102 @@
+/*
+ *  collection/src/join.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef join_h
+#define join_h
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "scheduler.h"
+#include "algorithms.h"
+
+/*
+ * The size above which the joins build and probe in parallel: each
+ * thread handles at least this many elements.
+ */
+#ifndef FNC_PARALLEL_JOIN_THRESHOLD
+#define FNC_PARALLEL_JOIN_THRESHOLD 65536
+#endif
+
+namespace fnc {
+
+    /*
+     * `join_table` is the hash table of a hash join: it maps each key of
+     * the build side to the positions holding it, in increasing order.
+     *
+     * The positions are chained through one `next` array, and the chains
+     * start from per-partition bucket arrays: with many keys, the keys are
+     * radix-partitioned on the high bits of their hash and the partitions
+     * are built in parallel, each one small enough to stay in cache.
+     */
+    template <typename K, typename Hash = std::hash<K> >
+    class join_table {
+
+    public :
+        join_table(std::vector<K> keys);
+
+        inline std::size_t size() const;
+
+        /*
+         * `probe` calls f(i) for each position i holding `key`, in
+         * increasing order, and returns whether there was any.
+         */
+        template <typename F>
+        bool probe(const K &key, F f) const;
+
+        bool contains(const K &key) const;
+
+    private :
+        static const std::size_t none = static_cast<std::size_t>(-1);
+
+        std::vector<K> keys;
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::size_t> next;
+        std::vector<std::vector<std::size_t>> heads;
+        unsigned partition_bits;
+        Hash hasher;
+
+        inline std::uint64_t hash_of(const K &key) const;
+
+        inline const std::vector<std::size_t> &buckets_of(std::uint64_t h) const;
+    };
+
+    /*
+     * `hash_join` joins `left` and `right` on key_a(x) == key_b(y),
+     * returning project(x,&y) for each matching pair. If `keep_unmatched`
+     * (a left join), it also returns project(x,nullptr) for each x with
+     * no match.
+     *
+     * The results come in the order of `left` and, for the same x, in the
+     * order of `right`, with the unmatched x of a left join in place. The
+     * hash table is built on the smaller side and probed from the larger
+     * one; when `left` is the smaller side, the matching positions are
+     * grouped by position in `left` before projecting. Long inputs are
+     * probed in parallel, in chunks whose results are concatenated in
+     * order: the result does not depend on the number of threads.
+     */
+    template <bool keep_unmatched, typename R, typename T, typename U, typename KA, typename KB, typename P>
+    fvec<R> hash_join(const fvec<T> &left, const fvec<U> &right, KA key_a, KB key_b, P project);
+
+    /*
+     * `hash_semi_join` returns the elements of `left` with (if
+     * `keep_matched`) or without a match in `right`, in order.
+     */
+    template <typename T, typename U, typename KA, typename KB>
+    fvec<T> hash_semi_join(const fvec<T> &left, const fvec<U> &right, KA key_a, KB key_b,
+                           bool keep_matched);
+
+}
+
+#include "join.cc"
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ *  collection/src/mem_scope.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+
+namespace fnc {
+
+    inline mem_account::mem_account(std::string name, std::shared_ptr<mem_account> parent)
+        : name(std::move(name)), parent(std::move(parent)),
+          allocated(0), freed(0), live(0), peak(0), allocations(0), deallocations(0) {}
+
+    inline void mem_account::on_allocate(std::size_t bytes)
+    {
+        for (mem_account *a = this; a != nullptr; a = a->parent.get()) {
+            a->allocated.fetch_add(bytes,std::memory_order_relaxed);
+            a->allocations.fetch_add(1,std::memory_order_relaxed);
+            std::size_t now = a->live.fetch_add(bytes,std::memory_order_relaxed) + bytes;
+            std::size_t high = a->peak.load(std::memory_order_relaxed);
+            while (now > high && !a->peak.compare_exchange_weak(high,now,std::memory_order_relaxed)) {}
+        }
+    }
+
+    inline void mem_account::on_deallocate(std::size_t bytes)
+    {
+        for (mem_account *a = this; a != nullptr; a = a->parent.get()) {
+            a->freed.fetch_add(bytes,std::memory_order_relaxed);
+            a->deallocations.fetch_add(1,std::memory_order_relaxed);
+            a->live.fetch_sub(bytes,std::memory_order_relaxed);
+        }
+    }
+
+    inline mem_scope::mem_scope(std::string name)
+        : account(std::make_shared<mem_account>(std::move(name),innermost()))
+    {
+        innermost() = account;
+    }
+
+    inline mem_scope::~mem_scope()
+    {
+        innermost() = account->parent;
+    }
+
+    inline mem_report mem_scope::report() const
+    {
+        mem_report r;
+        r.name = account->name;
+        r.allocated = account->allocated.load(std::memory_order_relaxed);
+        r.freed = account->freed.load(std::memory_order_relaxed);
+        r.live = account->live.load(std::memory_order_relaxed);
+        r.peak = account->peak.load(std::memory_order_relaxed);
+        r.allocations = account->allocations.load(std::memory_order_relaxed);
+        r.deallocations = account->deallocations.load(std::memory_order_relaxed);
+        return r;
+    }
+
+    inline std::shared_ptr<mem_account> mem_scope::current() { return innermost(); }
+
+    inline std::shared_ptr<mem_account> &mem_scope::innermost()
+    {
+        static thread_local std::shared_ptr<mem_account> scope;
+        return scope;
+    }
+
+    template <typename T, typename Base>
+    tracking_allocator<T,Base>::tracking_allocator() : alloc(), acc(mem_scope::current()) {}
+
+    template <typename T, typename Base>
+    tracking_allocator<T,Base>::tracking_allocator(const Base &base)
+        : alloc(base), acc(mem_scope::current()) {}
+
+    template <typename T, typename Base>
+    template <typename U, typename B>
+    tracking_allocator<T,Base>::tracking_allocator(const tracking_allocator<U,B> &other)
+        : alloc(other.alloc), acc(other.acc) {}
+
+    template <typename T, typename Base>
+    T *tracking_allocator<T,Base>::allocate(std::size_t n)
+    {
+        T *p = std::allocator_traits<Base>::allocate(alloc,n);
+        if (acc) acc->on_allocate(n * sizeof(T));
+        return p;
+    }
+
+    template <typename T, typename Base>
+    void tracking_allocator<T,Base>::deallocate(T *p, std::size_t n)
+    {
+        std::allocator_traits<Base>::deallocate(alloc,p,n);
+        if (acc) acc->on_deallocate(n * sizeof(T));
+    }
+
+    template <typename T, typename Base>
+    tracking_allocator<T,Base> tracking_allocator<T,Base>::select_on_container_copy_construction() const
+    {
+        return tracking_allocator<T,Base>(std::allocator_traits<Base>::select_on_container_copy_construction(alloc));
+    }
+
+    template <typename T, typename Base>
+    inline const std::shared_ptr<mem_account> &tracking_allocator<T,Base>::account() const { return acc; }
+
+    template <typename T, typename Base>
+    inline const Base &tracking_allocator<T,Base>::base() const { return alloc; }
+
+    template <typename T, typename A, typename U, typename B>
+    inline bool operator==(const tracking_allocator<T,A> &a, const tracking_allocator<U,B> &b)
+    {
+        return a.account() == b.account() && a.base() == b.base();
+    }
+
+    template <typename T, typename A, typename U, typename B>
+    inline bool operator!=(const tracking_allocator<T,A> &a, const tracking_allocator<U,B> &b)
+    {
+        return !(a == b);
+    }
+}
@@ -0,0 +1,200 @@
+/*
+ *  collection/src/mem_scope.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef mem_scope_h
+#define mem_scope_h
+
+#include <set>
+#include <list>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace fnc {
+
+    /*
+     * `mem_report` is a snapshot of the memory accounted to a scope, in
+     * bytes and number of allocations:
+     *
+     * - allocated, freed : the bytes allocated and freed so far;
+     * - live : the bytes allocated and not freed yet;
+     * - peak : the largest value reached by `live`.
+     */
+    struct mem_report {
+        std::string name;
+        std::size_t allocated;
+        std::size_t freed;
+        std::size_t live;
+        std::size_t peak;
+        std::size_t allocations;
+        std::size_t deallocations;
+    };
+
+    /*
+     * `mem_account` holds the counters of a scope. It lives as long as the
+     * scope or the containers created inside it, whichever lasts longer.
+     */
+    struct mem_account {
+        std::string name;
+        std::shared_ptr<mem_account> parent;
+        std::atomic<std::size_t> allocated;
+        std::atomic<std::size_t> freed;
+        std::atomic<std::size_t> live;
+        std::atomic<std::size_t> peak;
+        std::atomic<std::size_t> allocations;
+        std::atomic<std::size_t> deallocations;
+
+        inline mem_account(std::string name, std::shared_ptr<mem_account> parent);
+
+        /*
+         * `on_allocate` and `on_deallocate` count the bytes in this
+         * account and in all the enclosing ones.
+         */
+        inline void on_allocate(std::size_t bytes);
+
+        inline void on_deallocate(std::size_t bytes);
+    };
+
+    /*
+     * `mem_scope` accounts the memory of the containers created while it
+     * is alive, on the thread that created it:
+     *
+     *     {
+     *         fnc::mem_scope s("rollup");
+     *         auto groups = events.clusterize();
+     *         ...
+     *         fnc::mem_report r = s.report();     // r.peak, r.live, ...
+     *     }
+     *
+     * The scopes nest: the memory of an inner scope also counts in the
+     * outer ones. Every allocation of a container is accounted to the
+     * innermost scope alive when the container was created, or copied,
+     * for as long as the container lives; moving a container keeps its
+     * scope.
+     *
+     * Only the containers whose allocator is a `tracking_allocator` are
+     * accounted: fvec, flist and fset use one once
+     *
+     *     #define FNC_VEC_ALLOCATOR fnc::tracking_allocator
+     *     #define FNC_LIST_BACKEND fnc::tracked_list
+     *     #define FNC_SET_BACKEND fnc::tracked_set
+     *
+     * are defined before including the library.
+     *
+     * WARNING: the scope is per thread: the containers created by the
+     * tasks of the scheduler on other threads are not accounted to it.
+     */
+    class mem_scope {
+
+    public :
+        inline explicit mem_scope(std::string name);
+
+        mem_scope(const mem_scope &other) = delete;
+
+        mem_scope &operator=(const mem_scope &other) = delete;
+
+        /*
+         * WARNING: the scopes of a thread must end in the reverse order
+         * of their creation, as they do if they are local variables.
+         */
+        inline ~mem_scope();
+
+        inline mem_report report() const;
+
+        /*
+         * `current` returns the account of the innermost scope of the
+         * calling thread, or null outside every scope.
+         */
+        static inline std::shared_ptr<mem_account> current();
+
+    private :
+        std::shared_ptr<mem_account> account;
+
+        static inline std::shared_ptr<mem_account> &innermost();
+    };
+
+    /*
+     * `tracking_allocator` allocates through `Base` (std::allocator by
+     * default, or any other allocator, e.g. a `pool_allocator`) and
+     * accounts the bytes to the `mem_scope` current when it was created.
+     * Outside every scope it only forwards to `Base`.
+     *
+     * To track a custom allocator, wrap it in an alias:
+     *
+     *     template <typename T>
+     *     using tracked_arena = fnc::tracking_allocator<T,arena_allocator<T>>;
+     *
+     *     #define FNC_VEC_ALLOCATOR tracked_arena
+     */
+    template <typename T, typename Base = std::allocator<T> >
+    class tracking_allocator {
+
+    public :
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind {
+            typedef tracking_allocator<U,typename std::allocator_traits<Base>::template rebind_alloc<U> > other;
+        };
+
+        tracking_allocator();
+
+        explicit tracking_allocator(const Base &base);
+
+        template <typename U, typename B>
+        tracking_allocator(const tracking_allocator<U,B> &other);
+
+        T *allocate(std::size_t n);
+
+        void deallocate(T *p, std::size_t n);
+
+        /*
+         * The copy of a container is accounted to the scope current when
+         * it is made, not to the one of the original.
+         */
+        tracking_allocator<T,Base> select_on_container_copy_construction() const;
+
+        inline const std::shared_ptr<mem_account> &account() const;
+
+        inline const Base &base() const;
+
+    private :
+        Base alloc;
+        std::shared_ptr<mem_account> acc;
+
+        template <typename U, typename B>
+        friend class tracking_allocator;
+    };
+
+    template <typename T, typename A, typename U, typename B>
+    inline bool operator==(const tracking_allocator<T,A> &a, const tracking_allocator<U,B> &b);
+
+    template <typename T, typename A, typename U, typename B>
+    inline bool operator!=(const tracking_allocator<T,A> &a, const tracking_allocator<U,B> &b);
+
+    /*
+     * Tracked backends for `flist` and `fset`, as `pooled_list` and
+     * `pooled_set`.
+     */
+    template <typename T>
+    using tracked_list = std::list<T,tracking_allocator<T> >;
+
+    template <typename T>
+    using tracked_set = std::set<T,std::less<T>,tracking_allocator<T> >;
+
+}
+
+#include "mem_scope.cc"
+
+#endif
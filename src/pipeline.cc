@@ -0,0 +1,257 @@
+/*
+ *  collection/src/pipeline.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <thread>
+#include <utility>
+
+namespace fnc {
+
+    inline void pipeline_state::watch(std::function<void()> cancel)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancels.push_back(cancel);
+    }
+
+    inline void pipeline_state::fail(std::exception_ptr error)
+    {
+        std::vector<std::function<void()>> to_cancel;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (first_error == nullptr) first_error = error;
+            to_cancel = cancels;
+        }
+        for (auto const &cancel: to_cancel) {
+            cancel();
+        }
+    }
+
+    inline void pipeline_state::rethrow_if_failed()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (first_error != nullptr) std::rethrow_exception(first_error);
+    }
+
+    template <typename F>
+    map_stage<F> async_map(F f) { return map_stage<F>{f}; }
+
+    template <typename P>
+    filter_stage<P> async_filter(P predicate) { return filter_stage<P>{predicate}; }
+
+    template <typename F>
+    sink_stage<F> sink_each(F action) { return sink_stage<F>{action}; }
+
+    template <typename C>
+    auto sink_into(C &to)
+    {
+        return sink_each([&to](const typename C::value_type &x) { to.insert(to.end(),x); });
+    }
+
+    template <typename T>
+    pipeline<T>::pipeline()
+        : state(std::make_shared<pipeline_state>()),
+          output(std::make_shared<channel<T>>(FNC_PIPELINE_CAPACITY))
+    {
+        std::shared_ptr<channel<T>> out = output;
+        state->watch([out]() { out->cancel(); });
+    }
+
+    template <typename T>
+    pipeline<T> &pipeline<T>::operator=(pipeline<T> other)
+    {
+        std::swap(state,other.state);
+        std::swap(stages,other.stages);
+        std::swap(output,other.output);
+        return *this;
+    }
+
+    template <typename T>
+    pipeline<T> pipeline<T>::source(std::function<bool(T &)> next)
+    {
+        pipeline<T> p;
+        std::shared_ptr<channel<T>> out = p.output;
+        std::shared_ptr<pipeline_state> state = p.state;
+        p.stages.push_back([next,out,state]() {
+            try {
+                T elem;
+                std::vector<T> batch;
+                batch.reserve(FNC_PIPELINE_BATCH);
+                while (next(elem)) {
+                    batch.push_back(elem);
+                    if (batch.size() == FNC_PIPELINE_BATCH) {
+                        if (!out->push_all(batch)) return;
+                        batch.clear();
+                    }
+                }
+                if (!batch.empty() && !out->push_all(batch)) return;
+                out->close();
+            } catch (...) {
+                state->fail(std::current_exception());
+            }
+        });
+        return p;
+    }
+
+    template <typename T>
+    pipeline<T> pipeline<T>::source(std::shared_ptr<channel<T>> input)
+    {
+        pipeline<T> p;
+        p.output = input;
+        p.state->watch([input]() { input->cancel(); });
+        return p;
+    }
+
+    template <typename T>
+    template <typename U, typename Process>
+    pipeline<U> pipeline<T>::chain(Process process)
+    {
+        pipeline<U> next;
+        next.state = state;
+        next.stages = std::move(stages);
+
+        std::shared_ptr<channel<T>> in = output;
+        std::shared_ptr<channel<U>> out = next.output;
+        std::shared_ptr<pipeline_state> shared = state;
+        shared->watch([out]() { out->cancel(); });
+        next.stages.push_back([process,in,out,shared]() mutable {
+            try {
+                std::vector<T> batch;
+                std::vector<U> results;
+                bool more = true;
+                while (more && in->pop_n(batch,FNC_PIPELINE_BATCH) > 0) {
+                    more = process(batch,results);
+                    batch.clear();
+                    if (!out->push_all(results)) {
+                        // nobody reads the output any more: stop the
+                        // stages before this one too
+                        in->cancel();
+                        return;
+                    }
+                    results.clear();
+                }
+                if (!more) in->cancel();
+                out->close();
+            } catch (...) {
+                shared->fail(std::current_exception());
+            }
+        });
+        return next;
+    }
+
+    template <typename T>
+    template <typename F>
+    pipeline<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type>
+    pipeline<T>::operator|(map_stage<F> stage) &&
+    {
+        typedef typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type U;
+
+        F f = stage.f;
+        return this->template chain<U>([f](std::vector<T> &batch, std::vector<U> &results) mutable {
+            results.reserve(batch.size());
+            for (auto const &x: batch) {
+                results.push_back(f(x));
+            }
+            return true;
+        });
+    }
+
+    template <typename T>
+    template <typename P>
+    pipeline<T> pipeline<T>::operator|(filter_stage<P> stage) &&
+    {
+        P predicate = stage.predicate;
+        return this->template chain<T>([predicate](std::vector<T> &batch, std::vector<T> &results) mutable {
+            for (auto &x: batch) {
+                if (predicate(x))
+                    results.push_back(std::move(x));
+            }
+            return true;
+        });
+    }
+
+    template <typename T>
+    template <typename X, typename>
+    pipeline<typename X::template output<T>::type> pipeline<T>::operator|(X xf) &&
+    {
+        typedef typename X::template output<T>::type U;
+
+        // the step keeps its state (e.g. what `taking` counted) across
+        // the batches; `target` tells it where the current results go
+        auto target = std::make_shared<std::vector<U> *>(nullptr);
+        auto step = xf.template apply<T>([target](const U &y) {
+            (*target)->push_back(y);
+            return true;
+        });
+        return this->template chain<U>([target,step](std::vector<T> &batch, std::vector<U> &results) mutable {
+            *target = &results;
+            for (auto const &x: batch) {
+                if (!step(x)) return false;
+            }
+            return true;
+        });
+    }
+
+    template <typename T>
+    template <typename F>
+    void pipeline<T>::operator|(sink_stage<F> sink) &&
+    {
+        std::vector<std::thread> threads;
+        try {
+            for (auto &stage: stages) {
+                threads.emplace_back(std::move(stage));
+            }
+        } catch (...) {
+            // the stages already running stop on the cancelled channels
+            state->fail(std::current_exception());
+        }
+
+        try {
+            std::vector<T> batch;
+            while (output->pop_n(batch,FNC_PIPELINE_BATCH) > 0) {
+                for (auto const &x: batch) {
+                    sink.action(x);
+                }
+                batch.clear();
+            }
+        } catch (...) {
+            state->fail(std::current_exception());
+        }
+
+        for (auto &t: threads) {
+            t.join();
+        }
+        stages.clear();
+        state->rethrow_if_failed();
+    }
+
+    template <typename C>
+    pipeline<typename C::value_type> from_range(C container)
+    {
+        typedef typename C::value_type T;
+
+        auto elems = std::make_shared<C>(std::move(container));
+        auto i = std::make_shared<typename C::const_iterator>(elems->cbegin());
+        return pipeline<T>::source([elems,i](T &elem) {
+            if (*i == elems->cend()) return false;
+            elem = **i;
+            ++*i;
+            return true;
+        });
+    }
+
+    template <typename T>
+    pipeline<T> from_generator(std::function<bool(T &)> next)
+    {
+        return pipeline<T>::source(next);
+    }
+
+    template <typename T>
+    pipeline<T> from_channel(std::shared_ptr<channel<T>> input)
+    {
+        return pipeline<T>::source(input);
+    }
+}
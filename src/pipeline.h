@@ -0,0 +1,200 @@
+/*
+ *  collection/src/pipeline.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef pipeline_h
+#define pipeline_h
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include "channel.h"
+#include "transducer.h"
+
+/*
+ * The capacity of the channels between the stages of a pipeline: a stage
+ * more than this many elements ahead of the next one waits for it.
+ */
+#ifndef FNC_PIPELINE_CAPACITY
+#define FNC_PIPELINE_CAPACITY 1024
+#endif
+
+/*
+ * The most elements a stage takes from its input channel at once.
+ */
+#ifndef FNC_PIPELINE_BATCH
+#define FNC_PIPELINE_BATCH 64
+#endif
+
+namespace fnc {
+
+    /*
+     * `pipeline` runs each stage of a chain of operators on its own
+     * thread, connecting the stages with bounded `channel`s: a stage
+     * starts working on the first elements as soon as they arrive, while
+     * the source is still producing the others, and a fast stage waits
+     * for the slower ones instead of buffering without limits.
+     *
+     *     from_channel(chunks)
+     *         | async_map([](fvec<char> c) { return parse(c); })
+     *         | async_filter([](record r) { return r.valid(); })
+     *         | sink_each([](record r) { store(r); });
+     *
+     * The order of the elements is preserved. Any transducer can be a
+     * stage as well; one that stops the pass (e.g. `taking`) stops the
+     * stages before it too.
+     *
+     * Attaching a sink runs the pipeline: the sink runs on the calling
+     * thread, which returns when the source is exhausted. If a stage
+     * throws, the whole pipeline is cancelled and the exception is
+     * rethrown by the sink.
+     *
+     * A pipeline can only be run once: the operators consume it, so an
+     * lvalue pipeline must be moved, e.g. std::move(p) | sink_each(f).
+     */
+    template <typename T>
+    class pipeline;
+
+    /*
+     * `pipeline_state` is shared by all the stages of a pipeline: the
+     * first failure is recorded and cancels every channel.
+     */
+    class pipeline_state {
+
+    public :
+        inline void watch(std::function<void()> cancel);
+
+        inline void fail(std::exception_ptr error);
+
+        inline void rethrow_if_failed();
+
+    private :
+        std::mutex mutex;
+        std::exception_ptr first_error;
+        std::vector<std::function<void()>> cancels;
+    };
+
+    template <typename F>
+    struct map_stage {
+        F f;
+    };
+
+    template <typename P>
+    struct filter_stage {
+        P predicate;
+    };
+
+    template <typename F>
+    struct sink_stage {
+        F action;
+    };
+
+    /*
+     * `async_map` applies f to each element, on the thread of its stage.
+     */
+    template <typename F>
+    map_stage<F> async_map(F f);
+
+    /*
+     * `async_filter` keeps the elements that fullfill the predicate.
+     */
+    template <typename P>
+    filter_stage<P> async_filter(P predicate);
+
+    /*
+     * `sink_each` runs the pipeline, passing each result to `action`.
+     */
+    template <typename F>
+    sink_stage<F> sink_each(F action);
+
+    /*
+     * `sink_into` runs the pipeline, appending the results to `to`.
+     */
+    template <typename C>
+    auto sink_into(C &to);
+
+    template <typename T>
+    class pipeline {
+
+    public :
+        typedef T value_type;
+
+        pipeline(const pipeline<T> &other) = delete;
+
+        pipeline(pipeline<T> &&other) = default;
+
+        pipeline<T> &operator=(pipeline<T> other);
+
+        template <typename F>
+        pipeline<typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type>
+        operator|(map_stage<F> stage) &&;
+
+        template <typename P>
+        pipeline<T> operator|(filter_stage<P> stage) &&;
+
+        template <typename X,
+                  typename = typename std::enable_if<std::is_base_of<transducer_tag,X>::value>::type>
+        pipeline<typename X::template output<T>::type> operator|(X xf) &&;
+
+        template <typename F>
+        void operator|(sink_stage<F> sink) &&;
+
+        /*
+         * `source` returns a pipeline whose elements are produced on a
+         * thread of their own: `next` stores the next element in its
+         * argument and returns true, or returns false at the end.
+         * It can block, e.g. reading from a file or a socket. The
+         * elements are passed on in batches of FNC_PIPELINE_BATCH.
+         */
+        static pipeline<T> source(std::function<bool(T &)> next);
+
+        /*
+         * `source` returns a pipeline reading the elements that some
+         * other thread pushes into `input`, until it is closed.
+         */
+        static pipeline<T> source(std::shared_ptr<channel<T>> input);
+
+    private :
+        template <typename U> friend class pipeline;
+
+        std::shared_ptr<pipeline_state> state;
+        std::vector<std::function<void()>> stages;
+        std::shared_ptr<channel<T>> output;
+
+        pipeline();
+
+        /*
+         * `chain` adds a stage calling process(batch,results) on each
+         * batch of input elements; process returns false to stop
+         * reading the input.
+         */
+        template <typename U, typename Process>
+        pipeline<U> chain(Process process);
+    };
+
+    /*
+     * `from_range` returns a pipeline producing the elements of
+     * `container` (copied).
+     */
+    template <typename C>
+    pipeline<typename C::value_type> from_range(C container);
+
+    template <typename T>
+    pipeline<T> from_generator(std::function<bool(T &)> next);
+
+    template <typename T>
+    pipeline<T> from_channel(std::shared_ptr<channel<T>> input);
+
+}
+
+#include "pipeline.cc"
+
+#endif
@@ -0,0 +1,264 @@
+/*
+ *  collection/src/pool_allocator.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <new>
+
+namespace fnc {
+
+    /*
+     * `pool_registry` keeps the counters shared by all the node pools and
+     * the `release` function of each of them.
+     */
+    struct pool_registry {
+        std::mutex lock;
+        std::vector<std::size_t (*)()> pools;
+        std::atomic<std::size_t> slabs;
+        std::atomic<std::size_t> reserved;
+        std::atomic<std::size_t> outstanding;
+
+        pool_registry() : slabs(0), reserved(0), outstanding(0) {}
+
+        static pool_registry &instance()
+        {
+            // never destroyed: pooled containers may outlive the statics
+            static pool_registry *registry = new pool_registry;
+            return *registry;
+        }
+
+        static pool_stats &thread_stats()
+        {
+            static thread_local pool_stats stats = {0,0,0,0,0};
+            return stats;
+        }
+    };
+
+    template <std::size_t Size, std::size_t Align>
+    const std::size_t node_pool<Size,Align>::batch;
+
+    template <std::size_t Size, std::size_t Align>
+    const std::size_t node_pool<Size,Align>::slab_size;
+
+    template <std::size_t Size, std::size_t Align>
+    const std::size_t node_pool<Size,Align>::align;
+
+    template <std::size_t Size, std::size_t Align>
+    const std::size_t node_pool<Size,Align>::block_size;
+
+    template <std::size_t Size, std::size_t Align>
+    void *node_pool<Size,Align>::allocate()
+    {
+        pool_registry::thread_stats().allocations++;
+        if (cache_gone()) {
+            // the thread is exiting and its cache is gone
+            free_node *n = nullptr;
+            take(n,1);
+            return n;
+        }
+
+        cache &c = local();
+        if (c.free == nullptr) refill(c);
+
+        free_node *n = c.free;
+        c.free = n->next;
+        c.count--;
+        return n;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    void node_pool<Size,Align>::deallocate(void *p)
+    {
+        free_node *n = static_cast<free_node *>(p);
+        pool_registry::thread_stats().deallocations++;
+
+        if (cache_gone()) {
+            // the thread is exiting and its cache is gone
+            shared &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            n->next = g.free;
+            g.free = n;
+            g.outstanding--;
+            pool_registry::instance().outstanding--;
+            return;
+        }
+
+        cache &c = local();
+        n->next = c.free;
+        c.free = n;
+        if (++c.count > 2 * batch) flush(c,batch);
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    std::size_t node_pool<Size,Align>::release()
+    {
+        if (!cache_gone()) flush(local(),0);
+
+        shared &g = global();
+        std::lock_guard<std::mutex> guard(g.lock);
+        if (g.outstanding != 0) return 0;
+
+        std::size_t freed = g.slabs.size();
+        for (char *slab: g.slabs) {
+            ::operator delete(slab);
+        }
+        g.slabs.clear();
+        g.free = nullptr;
+        g.cursor = g.end = nullptr;
+        pool_registry::instance().slabs -= freed;
+        pool_registry::instance().reserved -= freed * slab_size;
+        return freed;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    typename node_pool<Size,Align>::shared &node_pool<Size,Align>::global()
+    {
+        static shared *g = []() {
+            shared *g = new shared;
+            g->free = nullptr;
+            g->cursor = g->end = nullptr;
+            g->outstanding = 0;
+
+            pool_registry &registry = pool_registry::instance();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            registry.pools.push_back(&node_pool<Size,Align>::release);
+            return g;
+        }();
+        return *g;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    typename node_pool<Size,Align>::cache &node_pool<Size,Align>::local()
+    {
+        static thread_local cache c;
+        return c;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    bool &node_pool<Size,Align>::cache_gone()
+    {
+        static thread_local bool gone = false;
+        return gone;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    std::size_t node_pool<Size,Align>::take(free_node *&list, std::size_t n)
+    {
+        shared &g = global();
+        std::lock_guard<std::mutex> guard(g.lock);
+
+        std::size_t taken = 0;
+        for (; taken < n && g.free != nullptr; ++taken) {
+            free_node *f = g.free;
+            g.free = f->next;
+            f->next = list;
+            list = f;
+        }
+
+        for (; taken < n; ++taken) {
+            if (g.cursor == g.end) {
+                // operator new aligns to alignof(std::max_align_t), which
+                // `pool_allocator` checks against `Align`
+                char *slab = static_cast<char *>(::operator new(slab_size));
+                g.slabs.push_back(slab);
+                g.cursor = slab;
+                g.end = slab + slab_size / block_size * block_size;
+                pool_registry::instance().slabs++;
+                pool_registry::instance().reserved += slab_size;
+            }
+            free_node *f = reinterpret_cast<free_node *>(g.cursor);
+            g.cursor += block_size;
+            f->next = list;
+            list = f;
+        }
+
+        g.outstanding += taken;
+        pool_registry::instance().outstanding += taken;
+        return taken;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    void node_pool<Size,Align>::refill(cache &c)
+    {
+        c.count += take(c.free,batch);
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    void node_pool<Size,Align>::flush(cache &c, std::size_t keep)
+    {
+        if (c.count <= keep) return;
+
+        // detach the blocks beyond the first `keep` ones
+        std::size_t given = c.count - keep;
+        free_node *first = c.free;
+        free_node *last = c.free;
+        for (std::size_t i = 1; i < given; ++i) {
+            last = last->next;
+        }
+        c.free = last->next;
+        c.count = keep;
+
+        shared &g = global();
+        std::lock_guard<std::mutex> guard(g.lock);
+        last->next = g.free;
+        g.free = first;
+        g.outstanding -= given;
+        pool_registry::instance().outstanding -= given;
+    }
+
+    template <std::size_t Size, std::size_t Align>
+    node_pool<Size,Align>::cache::cache() : free(nullptr), count(0) {}
+
+    template <std::size_t Size, std::size_t Align>
+    node_pool<Size,Align>::cache::~cache()
+    {
+        flush(*this,0);
+        cache_gone() = true;
+    }
+
+    template <typename T>
+    T *pool_allocator<T>::allocate(std::size_t n)
+    {
+        if (n != 1 || alignof(T) > alignof(std::max_align_t))
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(node_pool<sizeof(T),alignof(T)>::allocate());
+    }
+
+    template <typename T>
+    void pool_allocator<T>::deallocate(T *p, std::size_t n)
+    {
+        if (n != 1 || alignof(T) > alignof(std::max_align_t))
+            ::operator delete(p);
+        else
+            node_pool<sizeof(T),alignof(T)>::deallocate(p);
+    }
+
+    inline pool_stats allocation_stats()
+    {
+        pool_registry &registry = pool_registry::instance();
+        pool_stats stats = pool_registry::thread_stats();
+        stats.slabs = registry.slabs;
+        stats.reserved = registry.reserved;
+        stats.outstanding = registry.outstanding;
+        return stats;
+    }
+
+    inline std::size_t release_pools()
+    {
+        pool_registry &registry = pool_registry::instance();
+        std::vector<std::size_t (*)()> pools;
+        {
+            std::lock_guard<std::mutex> guard(registry.lock);
+            pools = registry.pools;
+        }
+
+        std::size_t freed = 0;
+        for (auto release: pools) {
+            freed += release();
+        }
+        return freed;
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ *  collection/src/pool_allocator.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef pool_allocator_h
+#define pool_allocator_h
+
+#include <set>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+namespace fnc {
+
+    /*
+     * `pool_stats` is a snapshot of the node pools.
+     *
+     * - slabs, reserved : slabs (and their bytes) held by all the pools;
+     * - outstanding : nodes handed out to the threads and not yet given
+     *                 back, including the ones cached by the threads;
+     * - allocations, deallocations : nodes allocated and freed by the
+     *                                calling thread.
+     */
+    struct pool_stats {
+        std::size_t slabs;
+        std::size_t reserved;
+        std::size_t outstanding;
+        std::size_t allocations;
+        std::size_t deallocations;
+    };
+
+    /*
+     * `node_pool` hands out blocks of `Size` bytes, carved out of 64KB
+     * slabs. There is one pool per block size, shared by every thread.
+     *
+     * Each thread keeps a cache of free blocks, refilled from (and flushed
+     * to) the pool in batches of `batch` blocks, so the pool lock is taken
+     * once every `batch` allocations. Freed blocks are recycled, never
+     * returned to the system: the slabs are released in bulk by `release`,
+     * once no block is in use anymore.
+     */
+    template <std::size_t Size, std::size_t Align>
+    class node_pool {
+
+    public :
+        static const std::size_t batch = 64;
+        static const std::size_t slab_size = 64 * 1024;
+
+        static void *allocate();
+
+        static void deallocate(void *p);
+
+        /*
+         * `release` gives the blocks cached by the calling thread back to
+         * the pool and, if no block is in use, frees all the slabs.
+         * It returns the number of slabs freed.
+         */
+        static std::size_t release();
+
+    private :
+        struct free_node {
+            free_node *next;
+        };
+
+        static const std::size_t align = Align > alignof(free_node) ? Align : alignof(free_node);
+        static const std::size_t block_size =
+            ((Size > sizeof(free_node) ? Size : sizeof(free_node)) + align - 1) / align * align;
+
+        struct shared {
+            std::mutex lock;
+            free_node *free;
+            std::vector<char *> slabs;
+            char *cursor;
+            char *end;
+            std::size_t outstanding;
+        };
+
+        struct cache {
+            free_node *free;
+            std::size_t count;
+
+            cache();
+            ~cache();
+        };
+
+        static shared &global();
+        static cache &local();
+
+        /*
+         * `cache_gone` is set once the cache of the calling thread has been
+         * destroyed: it is a plain bool, so it can still be read after that.
+         */
+        static bool &cache_gone();
+
+        static std::size_t take(free_node *&list, std::size_t n);
+        static void refill(cache &c);
+        static void flush(cache &c, std::size_t keep);
+    };
+
+    /*
+     * `pool_allocator` is a standard allocator that takes single objects
+     * from the `node_pool` of their size, and falls back to operator new
+     * for arrays and over-aligned types. It is stateless: all the
+     * instances compare equal.
+     *
+     * It is meant for node-based containers, which allocate one node per
+     * element:
+     *
+     *     std::list<int, pool_allocator<int>> l;
+     */
+    template <typename T>
+    class pool_allocator {
+
+    public :
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind {
+            typedef pool_allocator<U> other;
+        };
+
+        pool_allocator() noexcept {}
+
+        template <typename U>
+        pool_allocator(const pool_allocator<U> &) noexcept {}
+
+        T *allocate(std::size_t n);
+
+        void deallocate(T *p, std::size_t n);
+    };
+
+    template <typename T, typename U>
+    inline bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) { return true; }
+
+    template <typename T, typename U>
+    inline bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) { return false; }
+
+    /*
+     * Pooled backends for `flist` and `fset`:
+     *
+     *     flist<int, pooled_list> l = ...;
+     *     fset<int, pooled_set> s = ...;
+     *
+     * or, to make them the default for every flist and fset, define before
+     * including the library
+     *
+     *     #define FNC_LIST_BACKEND fnc::pooled_list
+     *     #define FNC_SET_BACKEND fnc::pooled_set
+     */
+    template <typename T>
+    using pooled_list = std::list<T,pool_allocator<T>>;
+
+    template <typename T>
+    using pooled_set = std::set<T,std::less<T>,pool_allocator<T>>;
+
+    /*
+     * `allocation_stats` returns the stats of all the node pools.
+     */
+    inline pool_stats allocation_stats();
+
+    /*
+     * `release_pools` calls `release` on every node pool used so far and
+     * returns the number of slabs freed.
+     */
+    inline std::size_t release_pools();
+
+}
+
+#include "pool_allocator.cc"
+
+#endif
@@ -0,0 +1,341 @@
+/*
+ *  collection/src/random.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <cmath>
+#include <random>
+#include <iterator>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_set>
+
+namespace fnc {
+
+    inline std::uint64_t rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline xoshiro256::xoshiro256(std::uint64_t seed, std::uint64_t stream)
+    {
+        // the state is expanded from the seed by splitmix64, as the
+        // authors of xoshiro recommend; the stream perturbs the seed
+        std::uint64_t x = seed ^ (stream * 0xd1342543de82ef95ULL);
+        for (auto &w: s) {
+            w = splitmix64(x);
+        }
+        if (stream != 0) {
+            std::uint64_t y = stream;
+            s[3] ^= splitmix64(y);
+        }
+    }
+
+    inline xoshiro256::result_type xoshiro256::operator()()
+    {
+        std::uint64_t result = rotl(s[1] * 5,7) * 9;
+        std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3],45);
+        return result;
+    }
+
+    inline std::uint64_t xoshiro256::bounded(std::uint64_t n)
+    {
+#if defined(__SIZEOF_INT128__)
+        // Lemire's multiply-shift, rejecting the few biased products
+        unsigned __int128 m = static_cast<unsigned __int128>((*this)()) * n;
+        std::uint64_t low = static_cast<std::uint64_t>(m);
+        if (low < n) {
+            std::uint64_t threshold = (0 - n) % n;
+            while (low < threshold) {
+                m = static_cast<unsigned __int128>((*this)()) * n;
+                low = static_cast<std::uint64_t>(m);
+            }
+        }
+        return static_cast<std::uint64_t>(m >> 64);
+#else
+        std::uint64_t threshold = (0 - n) % n;
+        std::uint64_t x;
+        do {
+            x = (*this)();
+        } while (x < threshold);
+        return x % n;
+#endif
+    }
+
+    inline double xoshiro256::uniform()
+    {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    inline void xoshiro256::jump()
+    {
+        static const std::uint64_t polynomial[] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+            0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+
+        std::uint64_t t[4] = {0,0,0,0};
+        for (auto p: polynomial) {
+            for (int b = 0; b < 64; ++b) {
+                if (p & (std::uint64_t(1) << b)) {
+                    for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) s[i] = t[i];
+    }
+
+    inline xoshiro256 &thread_rng()
+    {
+        thread_local xoshiro256 rng([]() {
+            std::random_device device;
+            return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+        }());
+        return rng;
+    }
+
+    template <typename Rng>
+    inline std::uint64_t draw_below(Rng &rng, std::uint64_t n)
+    {
+        return std::uniform_int_distribution<std::uint64_t>(0,n - 1)(rng);
+    }
+
+    inline std::uint64_t draw_below(xoshiro256 &rng, std::uint64_t n) { return rng.bounded(n); }
+
+    template <typename Rng>
+    inline double draw_uniform(Rng &rng)
+    {
+        return std::uniform_real_distribution<double>(0,1)(rng);
+    }
+
+    inline double draw_uniform(xoshiro256 &rng) { return rng.uniform(); }
+
+    template <typename RandomIt, typename Rng>
+    void shuffle_range(RandomIt first, RandomIt last, Rng &rng)
+    {
+        using std::swap;
+
+        std::uint64_t n = static_cast<std::uint64_t>(last - first);
+        for (std::uint64_t i = n; i > 1; --i) {
+            swap(first[i-1],first[draw_below(rng,i)]);
+        }
+    }
+
+    template <typename T>
+    void apply_permutation(fvec<T> &vec, const std::vector<std::size_t> &order,
+                           const std::vector<std::size_t> &starts, std::true_type)
+    {
+        // moving cannot throw: the elements are moved in parallel through
+        // raw storage, so T needs no default constructor
+        std::size_t n = vec.size();
+        std::size_t pieces = starts.size() - 1;
+        std::allocator<T> alloc;
+        T *moved = alloc.allocate(n);
+        parallel_for(0,pieces,[&](std::size_t q) {
+            for (std::size_t k = starts[q]; k < starts[q+1]; ++k) {
+                ::new (static_cast<void *>(moved + k)) T(std::move(vec[order[k]]));
+            }
+        },1);
+        parallel_for(0,pieces,[&](std::size_t q) {
+            for (std::size_t k = starts[q]; k < starts[q+1]; ++k) {
+                vec[k] = std::move(moved[k]);
+                moved[k].~T();
+            }
+        },1);
+        alloc.deallocate(moved,n);
+    }
+
+    template <typename T>
+    void apply_permutation(fvec<T> &vec, const std::vector<std::size_t> &order,
+                           const std::vector<std::size_t> &, std::false_type)
+    {
+        fvec<T> shuffled;
+        shuffled.reserve(vec.size());
+        for (auto i: order) {
+            shuffled.push_back(std::move(vec[i]));
+        }
+        vec.swap(shuffled);
+    }
+
+    template <typename T>
+    void parallel_shuffle(fvec<T> &vec, std::uint64_t seed)
+    {
+        // a fixed cap keeps the pieces², and the result, independent of
+        // the threads
+        const std::size_t max_pieces = 1024;
+
+        std::size_t n = vec.size();
+        std::size_t pieces = std::min(n / FNC_PARALLEL_SHUFFLE_THRESHOLD,max_pieces);
+        if (pieces < 2) {
+            xoshiro256 rng(seed);
+            shuffle_range(vec.begin(),vec.end(),rng);
+            return;
+        }
+
+        // the pieces depend on n only, and piece p of the input draws its
+        // targets from stream p: the result does not depend on the threads
+        std::size_t chunk = (n + pieces - 1) / pieces;
+        std::vector<std::uint32_t> target(n);
+        std::vector<std::size_t> counts(pieces * pieces,0);
+        parallel_for(0,pieces,[&](std::size_t p) {
+            xoshiro256 rng(seed,p + 1);
+            std::size_t *count = counts.data() + p * pieces;
+            for (std::size_t i = p * chunk; i < std::min(n,(p + 1) * chunk); ++i) {
+                target[i] = static_cast<std::uint32_t>(rng.bounded(pieces));
+                count[target[i]]++;
+            }
+        },1);
+
+        // the elements sent to piece q come after those sent to q - 1, and
+        // those from input piece p after those from p - 1
+        std::vector<std::size_t> offsets(pieces * pieces);
+        std::vector<std::size_t> starts(pieces + 1,0);
+        std::size_t offset = 0;
+        for (std::size_t q = 0; q < pieces; ++q) {
+            starts[q] = offset;
+            for (std::size_t p = 0; p < pieces; ++p) {
+                offsets[p * pieces + q] = offset;
+                offset += counts[p * pieces + q];
+            }
+        }
+        starts[pieces] = n;
+
+        // the indices are scattered and shuffled, then the elements are
+        // moved once to their final place
+        std::vector<std::size_t> order(n);
+        parallel_for(0,pieces,[&](std::size_t p) {
+            std::size_t *offset = offsets.data() + p * pieces;
+            for (std::size_t i = p * chunk; i < std::min(n,(p + 1) * chunk); ++i) {
+                order[offset[target[i]]++] = i;
+            }
+        },1);
+
+        parallel_for(0,pieces,[&](std::size_t q) {
+            xoshiro256 rng(seed,pieces + q + 1);
+            shuffle_range(order.begin() + starts[q],order.begin() + starts[q+1],rng);
+        },1);
+
+        apply_permutation(vec,order,starts,std::integral_constant<bool,
+            std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value>());
+    }
+
+    template <typename T, typename Rng>
+    fvec<T> sample(const fvec<T> &vec, std::size_t k, Rng &rng)
+    {
+        std::size_t n = vec.size();
+        if (k > n) throw "Cannot sample more elements than the vector has";
+
+        fvec<T> res;
+        res.reserve(k);
+        if (k < n / 8) {
+            // Floyd's algorithm: k distinct indices in O(k)
+            std::unordered_set<std::size_t> chosen;
+            std::vector<std::size_t> indices;
+            indices.reserve(k);
+            for (std::size_t j = n - k; j < n; ++j) {
+                std::size_t i = static_cast<std::size_t>(draw_below(rng,j + 1));
+                if (!chosen.insert(i).second) {
+                    i = j;
+                    chosen.insert(j);
+                }
+                indices.push_back(i);
+            }
+            std::sort(indices.begin(),indices.end());
+            for (auto i: indices) {
+                res.push_back(vec[i]);
+            }
+        } else {
+            // selection sampling: keep each element with probability
+            // (still needed) / (still to see)
+            for (std::size_t i = 0; i < n && res.size() < k; ++i) {
+                if (draw_below(rng,n - i) < k - res.size()) res.push_back(vec[i]);
+            }
+        }
+        return res;
+    }
+
+    template <typename T, typename W, typename Rng>
+    fvec<T> weighted_sample(const fvec<T> &vec, std::size_t k, W weight, Rng &rng)
+    {
+        // Efraimidis and Spirakis: the k largest keys u^(1/w), compared
+        // through log(u)/w, form a weighted sample without replacement
+        typedef std::pair<double,std::size_t> keyed;
+        std::vector<keyed> heap;
+        heap.reserve(k);
+        auto greater = [](const keyed &a, const keyed &b) { return a.first > b.first; };
+
+        if (k == 0) return fvec<T>();
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            double w = static_cast<double>(weight(vec[i]));
+            if (w < 0) throw "The weights must not be negative";
+            if (w == 0) continue;
+
+            double key = std::log(1.0 - draw_uniform(rng)) / w;
+            if (heap.size() < k) {
+                heap.push_back(keyed(key,i));
+                std::push_heap(heap.begin(),heap.end(),greater);
+            } else if (key > heap.front().first) {
+                std::pop_heap(heap.begin(),heap.end(),greater);
+                heap.back() = keyed(key,i);
+                std::push_heap(heap.begin(),heap.end(),greater);
+            }
+        }
+
+        std::sort(heap.begin(),heap.end(),greater);
+        fvec<T> res;
+        res.reserve(heap.size());
+        for (auto const &h: heap) {
+            res.push_back(vec[h.second]);
+        }
+        return res;
+    }
+
+    template <typename T>
+    reservoir<T>::reservoir(std::size_t k, std::uint64_t seed)
+        : k(k), count(0), next(0), w(1), rng(seed)
+    {
+        kept.reserve(k);
+    }
+
+    template <typename T>
+    void reservoir<T>::add(const T &elem)
+    {
+        if (kept.size() < k) {
+            kept.push_back(elem);
+            if (kept.size() == k) {
+                w = std::exp(std::log(1.0 - rng.uniform()) / k);
+                this->skip();
+            }
+        } else if (k > 0 && count == next) {
+            kept[rng.bounded(k)] = elem;
+            w *= std::exp(std::log(1.0 - rng.uniform()) / k);
+            this->skip();
+        }
+        count++;
+    }
+
+    template <typename T>
+    inline std::uint64_t reservoir<T>::seen() const { return count; }
+
+    template <typename T>
+    inline fvec<T> reservoir<T>::sample() const { return fvec<T>(kept); }
+
+    template <typename T>
+    void reservoir<T>::skip()
+    {
+        // the number of elements to skip is geometric with parameter w
+        double gap = std::floor(std::log(1.0 - rng.uniform()) / std::log1p(-w));
+        next = count + 1 + (gap < 1e18 ? static_cast<std::uint64_t>(gap) : std::uint64_t(1) << 60);
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ *  collection/src/random.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef random_h
+#define random_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "scheduler.h"
+#include "algorithms.h"
+
+/*
+ * The size above which `parallel_shuffle` splits the fvec into pieces of
+ * about this many elements, shuffled on different threads.
+ */
+#ifndef FNC_PARALLEL_SHUFFLE_THRESHOLD
+#define FNC_PARALLEL_SHUFFLE_THRESHOLD 65536
+#endif
+
+namespace fnc {
+
+    /*
+     * `xoshiro256` is the xoshiro256** generator: 256 bits of state, a
+     * period of 2^256 - 1, and a few cycles per number. It meets the
+     * requirements of a uniform random bit generator, so it also works
+     * with the distributions and algorithms of <random>.
+     *
+     * The same seed always gives the same numbers. Generators seeded with
+     * the same seed and different `stream`s, or copies advanced by `jump`,
+     * give independent sequences, e.g. one per thread.
+     */
+    class xoshiro256 {
+
+    public :
+        typedef std::uint64_t result_type;
+
+        static constexpr result_type min() { return 0; }
+
+        static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+        explicit xoshiro256(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+        inline result_type operator()();
+
+        /*
+         * `bounded` returns a uniform number in [0,n), n > 0.
+         */
+        inline std::uint64_t bounded(std::uint64_t n);
+
+        /*
+         * `uniform` returns a uniform double in [0,1).
+         */
+        inline double uniform();
+
+        /*
+         * `jump` advances the generator by 2^128 numbers: the copies of a
+         * generator jumped 0, 1, 2, ... times never overlap in practice.
+         */
+        void jump();
+
+    private :
+        std::uint64_t s[4];
+    };
+
+    /*
+     * `thread_rng` is a generator private to the calling thread, seeded
+     * from std::random_device: fast and safe to use from any thread, but
+     * not reproducible. Pass a seeded `xoshiro256` where that matters.
+     */
+    inline xoshiro256 &thread_rng();
+
+    /*
+     * `shuffle_range` shuffles [first,last) in place (Fisher-Yates).
+     */
+    template <typename RandomIt, typename Rng>
+    void shuffle_range(RandomIt first, RandomIt last, Rng &rng);
+
+    /*
+     * `parallel_shuffle` shuffles the fvec in place, uniformly and
+     * reproducibly: the result depends on `seed` only, not on the number
+     * of threads.
+     *
+     * Long fvecs are shuffled in parallel: each element is sent to a
+     * random piece (at most 1024 of them), then every piece is shuffled
+     * on its own. T needs no default constructor.
+     */
+    template <typename T>
+    void parallel_shuffle(fvec<T> &vec, std::uint64_t seed);
+
+    /*
+     * `sample` returns k distinct elements of the fvec (k at most its
+     * size), chosen uniformly at random, in the order of the fvec. It
+     * takes O(k) time for small k, O(n) otherwise.
+     */
+    template <typename T, typename Rng>
+    fvec<T> sample(const fvec<T> &vec, std::size_t k, Rng &rng);
+
+    /*
+     * `weighted_sample` returns k distinct elements of the fvec, chosen at
+     * random with probabilities proportional to weight(x), in the order in
+     * which they were drawn. The elements of weight 0 are never chosen.
+     * WARNING: the weights must not be negative.
+     */
+    template <typename T, typename W, typename Rng>
+    fvec<T> weighted_sample(const fvec<T> &vec, std::size_t k, W weight, Rng &rng);
+
+    /*
+     * `reservoir` keeps a uniform sample of k of the elements added to it,
+     * for streams too long to store or of unknown length:
+     *
+     *     reservoir<event> r(1000, seed);
+     *     for (auto &e: incoming) r.add(e);
+     *     fvec<event> picked = r.sample();
+     *
+     * Once full, it draws how many elements to skip before the next one
+     * to keep (Li's algorithm L), so most elements cost one comparison.
+     */
+    template <typename T>
+    class reservoir {
+
+    public :
+        reservoir(std::size_t k, std::uint64_t seed = 0);
+
+        void add(const T &elem);
+
+        /*
+         * `seen` is the number of elements added.
+         */
+        inline std::uint64_t seen() const;
+
+        inline fvec<T> sample() const;
+
+    private :
+        std::size_t k;
+        std::vector<T> kept;
+        std::uint64_t count;
+        std::uint64_t next;
+        double w;
+        xoshiro256 rng;
+
+        void skip();
+    };
+
+}
+
+#include "random.cc"
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ *  collection/src/scan.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace fnc {
+
+    template <typename T, typename Op>
+    inline T scan_kernel(const T *in, T *out, std::size_t n, T carry, Op &op)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            carry = op(carry,in[i]);
+            out[i] = carry;
+        }
+        return carry;
+    }
+
+#if defined(__SSE2__)
+    /*
+     * The SIMD kernels scan a register of lanes in log2(lanes) steps,
+     * combining it with a copy of itself shifted by 1, 2, ... lanes, then
+     * add the carry of the previous register. The shifted lanes are
+     * filled with zeros for (+), and with copies of the first lane for
+     * min and max, for which combining an element with itself is a no-op.
+     */
+    struct f32x4 {
+        typedef float T;
+        typedef __m128 V;
+        enum { lanes = 4 };
+
+        static inline V load(const T *p) { return _mm_loadu_ps(p); }
+        static inline void store(T *p, V x) { _mm_storeu_ps(p,x); }
+        static inline V set1(T x) { return _mm_set1_ps(x); }
+        static inline T last(V x) { return _mm_cvtss_f32(_mm_shuffle_ps(x,x,_MM_SHUFFLE(3,3,3,3))); }
+        static inline V broadcast_last(V x) { return _mm_shuffle_ps(x,x,_MM_SHUFFLE(3,3,3,3)); }
+        static inline V zero_shift(V x, int k)
+        {
+            __m128i i = _mm_castps_si128(x);
+            return _mm_castsi128_ps(k == 1 ? _mm_slli_si128(i,4) : _mm_slli_si128(i,8));
+        }
+        static inline V copy_shift(V x, int k)
+        {
+            return k == 1 ? _mm_shuffle_ps(x,x,_MM_SHUFFLE(2,1,0,0))
+                          : _mm_shuffle_ps(x,x,_MM_SHUFFLE(1,0,0,0));
+        }
+    };
+
+    struct i32x4 {
+        typedef int T;
+        typedef __m128i V;
+        enum { lanes = 4 };
+
+        static inline V load(const T *p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+        static inline void store(T *p, V x) { _mm_storeu_si128(reinterpret_cast<V *>(p),x); }
+        static inline V set1(T x) { return _mm_set1_epi32(x); }
+        static inline T last(V x) { return _mm_cvtsi128_si32(_mm_shuffle_epi32(x,_MM_SHUFFLE(3,3,3,3))); }
+        static inline V broadcast_last(V x) { return _mm_shuffle_epi32(x,_MM_SHUFFLE(3,3,3,3)); }
+        static inline V zero_shift(V x, int k) { return k == 1 ? _mm_slli_si128(x,4) : _mm_slli_si128(x,8); }
+        static inline V copy_shift(V x, int k)
+        {
+            return k == 1 ? _mm_shuffle_epi32(x,_MM_SHUFFLE(2,1,0,0))
+                          : _mm_shuffle_epi32(x,_MM_SHUFFLE(1,0,0,0));
+        }
+    };
+
+    struct f64x2 {
+        typedef double T;
+        typedef __m128d V;
+        enum { lanes = 2 };
+
+        static inline V load(const T *p) { return _mm_loadu_pd(p); }
+        static inline void store(T *p, V x) { _mm_storeu_pd(p,x); }
+        static inline V set1(T x) { return _mm_set1_pd(x); }
+        static inline T last(V x) { return _mm_cvtsd_f64(_mm_unpackhi_pd(x,x)); }
+        static inline V broadcast_last(V x) { return _mm_unpackhi_pd(x,x); }
+        static inline V zero_shift(V x, int) { return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x),8)); }
+        static inline V copy_shift(V x, int) { return _mm_unpacklo_pd(x,x); }
+    };
+
+    /*
+     * The lane-wise operators; `idempotent` tells which shift they need.
+     */
+    struct simd_plus {
+        enum { idempotent = false };
+        static inline __m128 apply(__m128 x, __m128 y) { return _mm_add_ps(x,y); }
+        static inline __m128i apply(__m128i x, __m128i y) { return _mm_add_epi32(x,y); }
+        static inline __m128d apply(__m128d x, __m128d y) { return _mm_add_pd(x,y); }
+    };
+
+    struct simd_min {
+        enum { idempotent = true };
+        static inline __m128 apply(__m128 x, __m128 y) { return _mm_min_ps(x,y); }
+#if defined(__SSE4_1__)
+        static inline __m128i apply(__m128i x, __m128i y) { return _mm_min_epi32(x,y); }
+#endif
+        static inline __m128d apply(__m128d x, __m128d y) { return _mm_min_pd(x,y); }
+    };
+
+    struct simd_max {
+        enum { idempotent = true };
+        static inline __m128 apply(__m128 x, __m128 y) { return _mm_max_ps(x,y); }
+#if defined(__SSE4_1__)
+        static inline __m128i apply(__m128i x, __m128i y) { return _mm_max_epi32(x,y); }
+#endif
+        static inline __m128d apply(__m128d x, __m128d y) { return _mm_max_pd(x,y); }
+    };
+
+    template <typename L, typename VOp, typename Op>
+    inline typename L::T simd_scan(const typename L::T *in, typename L::T *out, std::size_t n,
+                                   typename L::T carry, Op &op)
+    {
+        typedef typename L::V V;
+
+        std::size_t i = 0;
+        if (n >= L::lanes) {
+            V c = L::set1(carry);
+            for (; i + L::lanes <= n; i += L::lanes) {
+                V x = L::load(in + i);
+                for (int k = 1; k < L::lanes; k *= 2) {
+                    x = VOp::apply(x,VOp::idempotent ? L::copy_shift(x,k) : L::zero_shift(x,k));
+                }
+                x = VOp::apply(c,x);
+                L::store(out + i,x);
+                c = L::broadcast_last(x);
+            }
+            carry = L::last(c);
+        }
+        return scan_kernel<typename L::T,Op>(in + i,out + i,n - i,carry,op);
+    }
+
+    inline float scan_kernel(const float *in, float *out, std::size_t n, float carry, std::plus<float> &op)
+    {
+        return simd_scan<f32x4,simd_plus>(in,out,n,carry,op);
+    }
+
+    inline float scan_kernel(const float *in, float *out, std::size_t n, float carry, minimum<float> &op)
+    {
+        return simd_scan<f32x4,simd_min>(in,out,n,carry,op);
+    }
+
+    inline float scan_kernel(const float *in, float *out, std::size_t n, float carry, maximum<float> &op)
+    {
+        return simd_scan<f32x4,simd_max>(in,out,n,carry,op);
+    }
+
+    inline double scan_kernel(const double *in, double *out, std::size_t n, double carry, std::plus<double> &op)
+    {
+        return simd_scan<f64x2,simd_plus>(in,out,n,carry,op);
+    }
+
+    inline double scan_kernel(const double *in, double *out, std::size_t n, double carry, minimum<double> &op)
+    {
+        return simd_scan<f64x2,simd_min>(in,out,n,carry,op);
+    }
+
+    inline double scan_kernel(const double *in, double *out, std::size_t n, double carry, maximum<double> &op)
+    {
+        return simd_scan<f64x2,simd_max>(in,out,n,carry,op);
+    }
+
+    inline int scan_kernel(const int *in, int *out, std::size_t n, int carry, std::plus<int> &op)
+    {
+        return simd_scan<i32x4,simd_plus>(in,out,n,carry,op);
+    }
+
+#if defined(__SSE4_1__)
+    inline int scan_kernel(const int *in, int *out, std::size_t n, int carry, minimum<int> &op)
+    {
+        return simd_scan<i32x4,simd_min>(in,out,n,carry,op);
+    }
+
+    inline int scan_kernel(const int *in, int *out, std::size_t n, int carry, maximum<int> &op)
+    {
+        return simd_scan<i32x4,simd_max>(in,out,n,carry,op);
+    }
+#endif
+#endif
+
+    template <typename T, typename Op>
+    T scan_from(const T *in, T *out, std::size_t n, T carry, Op op)
+    {
+        std::size_t chunks = std::min<std::size_t>(scheduler::instance().concurrency(),
+                                                   n / FNC_PARALLEL_SCAN_THRESHOLD);
+        if (chunks < 2) return scan_kernel(in,out,n,carry,op);
+
+        // first pass: the total of each chunk
+        std::size_t chunk = (n + chunks - 1) / chunks;
+        std::vector<T> totals(chunks,carry);
+        parallel_for(0,chunks,[in,n,chunk,&totals,&op](std::size_t c) {
+            std::size_t first = c * chunk;
+            std::size_t last = std::min(n,first + chunk);
+            T acc = in[first];
+            for (std::size_t i = first + 1; i < last; ++i) {
+                acc = op(acc,in[i]);
+            }
+            totals[c] = acc;
+        },1);
+
+        // the carry of each chunk is the fold of the ones before it
+        std::vector<T> carries(chunks,carry);
+        for (std::size_t c = 1; c < chunks; ++c) {
+            carries[c] = op(carries[c-1],totals[c-1]);
+        }
+
+        // second pass: scan each chunk from its carry
+        parallel_for(0,chunks,[in,out,n,chunk,&carries,&op](std::size_t c) {
+            std::size_t first = c * chunk;
+            std::size_t last = std::min(n,first + chunk);
+            Op chunk_op(op);
+            scan_kernel(in + first,out + first,last - first,carries[c],chunk_op);
+        },1);
+        return op(carries[chunks-1],totals[chunks-1]);
+    }
+
+    template <typename T, typename Op>
+    void inclusive_scan(const T *in, T *out, std::size_t n, Op op)
+    {
+        if (n == 0) return;
+
+        T first = in[0];
+        out[0] = first;
+        scan_from(in + 1,out + 1,n - 1,first,op);
+    }
+
+    template <typename T, typename Op>
+    void exclusive_scan(const T *in, T *out, std::size_t n, T init, Op op)
+    {
+        if (n == 0) return;
+
+        out[0] = init;
+        scan_from(in,out + 1,n - 1,init,op);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ *  collection/src/scan.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef scan_h
+#define scan_h
+
+#include <cstddef>
+#include <functional>
+#include "scheduler.h"
+
+/*
+ * The size above which the scans run in parallel: each thread scans at
+ * least this many elements.
+ */
+#ifndef FNC_PARALLEL_SCAN_THRESHOLD
+#define FNC_PARALLEL_SCAN_THRESHOLD 65536
+#endif
+
+namespace fnc {
+
+    /*
+     * `minimum` and `maximum` are the function objects for min and max,
+     * as std::plus is for (+). Scanning with std::plus, minimum or maximum
+     * over int, float or double uses SIMD kernels where available (SSE2;
+     * SSE4.1 for the int min and max).
+     */
+    template <typename T>
+    struct minimum {
+        inline T operator()(const T &x, const T &y) const { return y < x ? y : x; }
+    };
+
+    template <typename T>
+    struct maximum {
+        inline T operator()(const T &x, const T &y) const { return x < y ? y : x; }
+    };
+
+    /*
+     * `scan_from` writes in out[i] the fold of carry, in[0], ..., in[i]
+     * with `op`, for each i in [0,n), and returns the last one (carry if n
+     * is 0). `in` and `out` can be the same array.
+     *
+     * Above FNC_PARALLEL_SCAN_THRESHOLD elements per thread, the scan runs
+     * in two parallel passes over chunks of the input: the first one
+     * reduces each chunk, then the totals of the chunks before each one
+     * are folded, and the second pass scans each chunk starting from them.
+     * WARNING: `op` must be associative, since the parallel scan and the
+     * SIMD kernels regroup the operations; floating point results can
+     * then differ in the last bits from a sequential scan.
+     */
+    template <typename T, typename Op>
+    T scan_from(const T *in, T *out, std::size_t n, T carry, Op op);
+
+    /*
+     * `inclusive_scan` writes in out[i] the fold of in[0], ..., in[i].
+     */
+    template <typename T, typename Op>
+    void inclusive_scan(const T *in, T *out, std::size_t n, Op op);
+
+    /*
+     * `exclusive_scan` writes in out[i] the fold of init, in[0], ...,
+     * in[i-1]: out[0] is init.
+     * WARNING: `in` and `out` must not overlap.
+     */
+    template <typename T, typename Op>
+    void exclusive_scan(const T *in, T *out, std::size_t n, T init, Op op);
+
+}
+
+#include "scan.cc"
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ *  collection/src/scheduler.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <utility>
+#include <algorithm>
+#include <system_error>
+
+namespace fnc {
+
+    /*
+     * The scheduler a thread works for, and the index of its deque.
+     */
+    struct worker_slot {
+        const scheduler *owner;
+        std::size_t index;
+    };
+
+    inline worker_slot &this_worker()
+    {
+        static thread_local worker_slot slot = {nullptr,0};
+        return slot;
+    }
+
+    inline scheduler &scheduler::instance()
+    {
+        static scheduler shared(FNC_SCHEDULER_THREADS > 0
+                                ? FNC_SCHEDULER_THREADS
+                                : std::max(std::thread::hardware_concurrency(),1u) - 1);
+        return shared;
+    }
+
+    inline scheduler::scheduler(std::size_t threads)
+        : queued(0), sleeping(0), stopping(false)
+    {
+        for (std::size_t i = 0; i <= threads; ++i) {
+            deques.emplace_back(new task_deque());
+        }
+
+        for (std::size_t i = 0; i < threads; ++i) {
+            try {
+                workers.emplace_back([this,i]() { this->work(i); });
+            } catch (const std::system_error &) {
+                // no more threads available: make do with the ones started
+                break;
+            }
+        }
+    }
+
+    inline scheduler::~scheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto &w: workers) {
+            w.join();
+        }
+    }
+
+    inline std::size_t scheduler::concurrency() const { return workers.size() + 1; }
+
+    inline std::size_t scheduler::own_deque() const
+    {
+        worker_slot &slot = this_worker();
+        return slot.owner == this ? slot.index : deques.size() - 1;
+    }
+
+    inline void scheduler::submit(std::function<void()> job)
+    {
+        task_deque &d = *deques[own_deque()];
+        {
+            std::lock_guard<std::mutex> lock(d.mutex);
+            d.tasks.push_back(std::move(job));
+        }
+        queued++;
+
+        // a worker going to sleep counts itself before checking `queued`
+        // under sleep_mutex: taking the mutex here makes sure it is either
+        // waiting, and gets notified, or has seen the new task
+        if (sleeping > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wakeup.notify_one();
+    }
+
+    inline bool scheduler::take(std::size_t index, bool back, std::function<void()> &job)
+    {
+        task_deque &d = *deques[index];
+        std::lock_guard<std::mutex> lock(d.mutex);
+        if (d.tasks.empty()) return false;
+
+        if (back) {
+            job = std::move(d.tasks.back());
+            d.tasks.pop_back();
+        } else {
+            job = std::move(d.tasks.front());
+            d.tasks.pop_front();
+        }
+        queued--;
+        return true;
+    }
+
+    inline bool scheduler::run_one()
+    {
+        if (queued == 0) return false;
+
+        std::size_t own = this->own_deque();
+        std::size_t n = deques.size();
+        std::function<void()> job;
+
+        // the newest task of our own deque first, then steal the oldest
+        // ones of the others, starting from our neighbour
+        bool found = this->take(own,true,job);
+        for (std::size_t i = 1; !found && i < n; ++i) {
+            found = this->take((own + i) % n,false,job);
+        }
+        if (!found) return false;
+
+        job();
+        return true;
+    }
+
+    inline void scheduler::work(std::size_t index)
+    {
+        this_worker() = worker_slot{this,index};
+
+        while (!stopping) {
+            if (this->run_one()) continue;
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping++;
+            wakeup.wait(lock,[this]() { return queued > 0 || stopping; });
+            sleeping--;
+        }
+    }
+
+    inline task_group::task_group(scheduler &sched) : sched(sched), pending(0) {}
+
+    inline task_group::~task_group() { this->wait_all(); }
+
+    template <typename F>
+    void task_group::run(F f)
+    {
+        pending++;
+        sched.submit([this,f]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (error == nullptr) error = std::current_exception();
+            }
+            pending--;
+        });
+    }
+
+    inline void task_group::wait_all()
+    {
+        while (pending > 0) {
+            if (!sched.run_one())
+                std::this_thread::yield();
+        }
+    }
+
+    inline void task_group::wait()
+    {
+        this->wait_all();
+
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            std::swap(e,error);
+        }
+        if (e != nullptr) std::rethrow_exception(e);
+    }
+
+    template <typename A, typename B>
+    void fork_join(A a, B b)
+    {
+        task_group g;
+        g.run(b);
+        a();
+        g.wait();
+    }
+
+    template <typename F>
+    void parallel_for_range(task_group &g, std::size_t first, std::size_t last,
+                            std::size_t grain, F &f)
+    {
+        // keep the first half and hand out the second one, down to grain
+        while (last - first > grain) {
+            std::size_t middle = first + (last - first) / 2;
+            g.run([&g,&f,middle,last,grain]() { parallel_for_range(g,middle,last,grain,f); });
+            last = middle;
+        }
+        for (; first < last; ++first) {
+            f(first);
+        }
+    }
+
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, F f, std::size_t grain)
+    {
+        if (first >= last) return;
+
+        scheduler &sched = scheduler::instance();
+        if (grain == 0)
+            grain = std::max<std::size_t>((last - first) / (8 * sched.concurrency()),1);
+
+        task_group g(sched);
+        parallel_for_range(g,first,last,grain,f);
+        g.wait();
+    }
+
+    template <typename T, typename F>
+    void parallel_foreach(fvec<T> &vec, F f, std::size_t grain)
+    {
+        parallel_for(0,vec.size(),[&vec,&f](std::size_t i) { f(vec[i]); },grain);
+    }
+
+    template <typename T, typename F>
+    void parallel_foreach_nested(fvec<fvec<T>> &groups, F f, std::size_t grain)
+    {
+        // one task per group: a large group is split again by its own
+        // parallel_foreach, and its pieces are stolen by the idle workers
+        parallel_for(0,groups.size(),[&groups,&f,grain](std::size_t i) {
+            parallel_foreach(groups[i],f,grain);
+        },1);
+    }
+}
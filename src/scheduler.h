@@ -0,0 +1,197 @@
+/*
+ *  collection/src/scheduler.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef scheduler_h
+#define scheduler_h
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+/*
+ * The number of worker threads of the default scheduler; 0 means one
+ * less than the hardware threads, since the thread waiting for a task
+ * group works too.
+ */
+#ifndef FNC_SCHEDULER_THREADS
+#define FNC_SCHEDULER_THREADS 0
+#endif
+
+namespace fnc {
+
+    template <typename T>
+    class fvec;
+
+    /*
+     * `scheduler` is a work-stealing task scheduler. Every worker thread
+     * owns a deque of tasks: it pushes and pops the tasks it spawns at
+     * the back, while the idle workers steal from the front of the other
+     * deques, i.e. the oldest (and usually largest) pieces of work.
+     *
+     * A thread waiting for a `task_group` runs the pending tasks instead
+     * of blocking, so parallel operations can be nested at any depth
+     * (e.g. a parallel map over each group of a parallel group-by)
+     * without deadlocking or running out of threads, and skewed
+     * workloads balance themselves: the workers done early steal from
+     * the busy ones.
+     *
+     * The parallel operators of the library run on `scheduler::instance()`.
+     */
+    class scheduler {
+
+    public :
+        /*
+         * `instance` returns the scheduler shared by the library, with
+         * FNC_SCHEDULER_THREADS workers.
+         */
+        static inline scheduler &instance();
+
+        /*
+         * A scheduler with `threads` worker threads (possibly 0: the tasks
+         * then run on the threads waiting for them).
+         */
+        inline scheduler(std::size_t threads);
+
+        scheduler(const scheduler &other) = delete;
+
+        scheduler &operator=(const scheduler &other) = delete;
+
+        inline ~scheduler();
+
+        /*
+         * `concurrency` is the number of threads working on the tasks:
+         * the workers and the thread waiting for them.
+         */
+        inline std::size_t concurrency() const;
+
+        /*
+         * `submit` queues `job`: on the deque of the calling thread if it
+         * is a worker, otherwise on a shared one.
+         */
+        inline void submit(std::function<void()> job);
+
+        /*
+         * `run_one` runs one pending task, its own or a stolen one, and
+         * returns false if there was none.
+         */
+        inline bool run_one();
+
+    private :
+        struct task_deque {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /*
+         * deques[i] belongs to the i-th worker; the last one is shared by
+         * the threads that are not workers.
+         */
+        std::vector<std::unique_ptr<task_deque>> deques;
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> queued;
+        std::atomic<std::size_t> sleeping;
+        std::atomic<bool> stopping;
+        std::mutex sleep_mutex;
+        std::condition_variable wakeup;
+
+        inline void work(std::size_t index);
+
+        inline std::size_t own_deque() const;
+
+        inline bool take(std::size_t index, bool back, std::function<void()> &job);
+    };
+
+    /*
+     * `task_group` forks tasks on a scheduler and joins them:
+     *
+     *     task_group g;
+     *     g.run([&]() { left = sum(a); });      // fork
+     *     right = sum(b);
+     *     g.wait();                             // join
+     *
+     * The first exception thrown by a task is rethrown by `wait`.
+     */
+    class task_group {
+
+    public :
+        inline task_group(scheduler &sched = scheduler::instance());
+
+        task_group(const task_group &other) = delete;
+
+        task_group &operator=(const task_group &other) = delete;
+
+        /*
+         * The destructor waits for the tasks still running, ignoring
+         * their errors.
+         */
+        inline ~task_group();
+
+        template <typename F>
+        void run(F f);
+
+        /*
+         * `wait` runs pending tasks until all the tasks of the group are
+         * done.
+         */
+        inline void wait();
+
+    private :
+        scheduler &sched;
+        std::atomic<std::size_t> pending;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+
+        inline void wait_all();
+    };
+
+    /*
+     * `fork_join` runs `a` and `b` in parallel and returns when both are
+     * done.
+     */
+    template <typename A, typename B>
+    void fork_join(A a, B b);
+
+    /*
+     * `parallel_for` calls f(i) for each i in [first,last). The range is
+     * split in halves down to `grain` indices, lazily: the halves not
+     * stolen by another worker are run by the one that split them.
+     * A grain of 0 picks one giving some 8 pieces per thread.
+     */
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, F f, std::size_t grain = 0);
+
+    /*
+     * `parallel_foreach` calls f on each element of the fvec, in parallel.
+     */
+    template <typename T, typename F>
+    void parallel_foreach(fvec<T> &vec, F f, std::size_t grain = 0);
+
+    /*
+     * `parallel_foreach_nested` calls f on each element of each group,
+     * splitting both the groups and the large groups between the threads.
+     *
+     * Example:
+     *
+     *     fvec<fvec<int>> groups = v.clusterize();
+     *     parallel_foreach_nested(groups,[](int &x) { x = expensive(x); });
+     */
+    template <typename T, typename F>
+    void parallel_foreach_nested(fvec<fvec<T>> &groups, F f, std::size_t grain = 0);
+
+}
+
+#include "scheduler.cc"
+
+#endif
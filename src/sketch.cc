@@ -0,0 +1,471 @@
+/*
+ *  collection/src/sketch.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+namespace fnc {
+
+    /*
+     * The serialized sketches are a tag byte followed by their fields, as
+     * little-endian 64-bit words.
+     */
+    inline void put_word(std::vector<std::uint8_t> &out, std::uint64_t x)
+    {
+        for (int i = 0; i < 8; ++i) {
+            out.push_back(static_cast<std::uint8_t>(x >> (8 * i)));
+        }
+    }
+
+    inline void put_double(std::vector<std::uint8_t> &out, double x)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits,&x,sizeof(bits));
+        put_word(out,bits);
+    }
+
+    inline std::uint64_t get_word(const std::vector<std::uint8_t> &in, std::size_t &pos)
+    {
+        if (in.size() < pos + 8) throw "Corrupted sketch";
+
+        std::uint64_t x = 0;
+        for (int i = 0; i < 8; ++i) {
+            x |= static_cast<std::uint64_t>(in[pos++]) << (8 * i);
+        }
+        return x;
+    }
+
+    inline double get_double(const std::vector<std::uint8_t> &in, std::size_t &pos)
+    {
+        std::uint64_t bits = get_word(in,pos);
+        double x;
+        std::memcpy(&x,&bits,sizeof(x));
+        return x;
+    }
+
+    template <typename S, typename It>
+    void sketch_range(S &sketch, It first, It last, std::input_iterator_tag)
+    {
+        for (; first != last; ++first) {
+            sketch.add(*first);
+        }
+    }
+
+    template <typename S, typename It>
+    void sketch_range(S &sketch, It first, It last, std::random_access_iterator_tag)
+    {
+        std::size_t n = static_cast<std::size_t>(last - first);
+        std::size_t chunks = std::min<std::size_t>(scheduler::instance().concurrency(),
+                                                   n / FNC_PARALLEL_SKETCH_THRESHOLD);
+        if (chunks < 2) {
+            sketch_range(sketch,first,last,std::input_iterator_tag());
+            return;
+        }
+
+        // sketch the chunks on copies of the (empty) sketch, then merge them
+        std::vector<S> parts(chunks,sketch);
+        std::size_t chunk = (n + chunks - 1) / chunks;
+        parallel_for(0,chunks,[&parts,first,n,chunk](std::size_t c) {
+            std::size_t begin = c * chunk;
+            std::size_t end = std::min(n,begin + chunk);
+            sketch_range(parts[c],first + begin,first + end,std::input_iterator_tag());
+        },1);
+        for (auto const &part: parts) {
+            sketch.merge(part);
+        }
+    }
+
+    /*
+     * `sketch_all` adds every element of `container` to the empty sketch,
+     * in parallel for long random-access containers.
+     */
+    template <typename S, typename C>
+    void sketch_all(S &sketch, const C &container)
+    {
+        typedef decltype(std::begin(container)) It;
+        sketch_range(sketch,std::begin(container),std::end(container),
+                     typename std::iterator_traits<It>::iterator_category());
+    }
+
+    inline unsigned leading_zeros(std::uint64_t x)
+    {
+        if (x == 0) return 64;
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_clzll(x));
+#else
+        unsigned n = 0;
+        for (; (x & (std::uint64_t(1) << 63)) == 0; x <<= 1) {
+            n++;
+        }
+        return n;
+#endif
+    }
+
+    template <typename T, typename Hash>
+    hyperloglog<T,Hash>::hyperloglog(unsigned precision) : p(precision)
+    {
+        if (precision < 4 || precision > 18) throw "precision must be in the range [4,18]";
+        registers.assign(std::size_t(1) << precision,0);
+    }
+
+    template <typename T, typename Hash>
+    template <typename C, typename>
+    hyperloglog<T,Hash>::hyperloglog(const C &container, unsigned precision)
+        : hyperloglog(precision)
+    {
+        sketch_all(*this,container);
+    }
+
+    template <typename T, typename Hash>
+    void hyperloglog<T,Hash>::add(const T &elem)
+    {
+        // the first p bits of the hash pick the register, which keeps the
+        // longest run of leading zeros seen in the rest
+        std::uint64_t h = mix64(static_cast<std::uint64_t>(hasher(elem)));
+        std::size_t index = static_cast<std::size_t>(h >> (64 - p));
+        std::uint8_t rank = static_cast<std::uint8_t>(std::min(leading_zeros(h << p),64 - p) + 1);
+        if (registers[index] < rank) registers[index] = rank;
+    }
+
+    template <typename T, typename Hash>
+    void hyperloglog<T,Hash>::merge(const hyperloglog<T,Hash> &other)
+    {
+        if (other.p != p) throw "Cannot merge sketches of different precisions";
+
+        for (std::size_t i = 0; i < registers.size(); ++i) {
+            registers[i] = std::max(registers[i],other.registers[i]);
+        }
+    }
+
+    template <typename T, typename Hash>
+    double hyperloglog<T,Hash>::estimate() const
+    {
+        double m = static_cast<double>(registers.size());
+        double alpha = p == 4 ? 0.673 : p == 5 ? 0.697 : p == 6 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+
+        double harmonic = 0;
+        std::size_t zeros = 0;
+        for (auto r: registers) {
+            harmonic += std::ldexp(1.0,-static_cast<int>(r));
+            if (r == 0) zeros++;
+        }
+        double e = alpha * m * m / harmonic;
+
+        // few elements: linear counting on the empty registers is better
+        if (e <= 2.5 * m && zeros > 0) return m * std::log(m / zeros);
+        return e;
+    }
+
+    template <typename T, typename Hash>
+    inline unsigned hyperloglog<T,Hash>::precision() const { return p; }
+
+    template <typename T, typename Hash>
+    std::vector<std::uint8_t> hyperloglog<T,Hash>::serialize() const
+    {
+        std::vector<std::uint8_t> out;
+        out.reserve(2 + registers.size());
+        out.push_back('H');
+        out.push_back(static_cast<std::uint8_t>(p));
+        out.insert(out.end(),registers.begin(),registers.end());
+        return out;
+    }
+
+    template <typename T, typename Hash>
+    hyperloglog<T,Hash> hyperloglog<T,Hash>::deserialize(const std::vector<std::uint8_t> &bytes)
+    {
+        if (bytes.size() < 2 || bytes[0] != 'H') throw "Corrupted sketch";
+
+        hyperloglog<T,Hash> sketch(bytes[1]);
+        if (bytes.size() != 2 + sketch.registers.size()) throw "Corrupted sketch";
+        std::copy(bytes.begin() + 2,bytes.end(),sketch.registers.begin());
+        return sketch;
+    }
+
+    inline tdigest::tdigest(double compression)
+        : compression(compression), total(0),
+          min(std::numeric_limits<double>::infinity()),
+          max(-std::numeric_limits<double>::infinity())
+    {
+        if (compression < 10) throw "compression must be at least 10";
+    }
+
+    template <typename C, typename>
+    tdigest::tdigest(const C &container, double compression) : tdigest(compression)
+    {
+        sketch_all(*this,container);
+    }
+
+    inline void tdigest::add(double x, double weight)
+    {
+        if (weight <= 0) return;
+
+        buffer.push_back(centroid{x,weight});
+        min = std::min(min,x);
+        max = std::max(max,x);
+        if (buffer.size() >= 8 * static_cast<std::size_t>(compression)) this->compress();
+    }
+
+    inline void tdigest::merge(const tdigest &other)
+    {
+        buffer.insert(buffer.end(),other.centroids.begin(),other.centroids.end());
+        buffer.insert(buffer.end(),other.buffer.begin(),other.buffer.end());
+        min = std::min(min,other.min);
+        max = std::max(max,other.max);
+        this->compress();
+    }
+
+    inline double tdigest::quantile(double q)
+    {
+        this->compress();
+        if (centroids.empty()) throw "Cannot calculate the quantile of an empty digest";
+        if (q <= 0) return min;
+        if (q >= 1) return max;
+
+        // every centroid stands for its weight spread around its mean:
+        // interpolate between the means of the two centroids around the
+        // target rank, and with min and max at the ends
+        double target = q * total;
+        double first = centroids.front().weight / 2;
+        if (target < first) {
+            return min + (centroids.front().mean - min) * target / first;
+        }
+
+        double cumulative = first;
+        for (std::size_t i = 0; i + 1 < centroids.size(); ++i) {
+            double step = (centroids[i].weight + centroids[i+1].weight) / 2;
+            if (target < cumulative + step) {
+                double t = (target - cumulative) / step;
+                return centroids[i].mean + (centroids[i+1].mean - centroids[i].mean) * t;
+            }
+            cumulative += step;
+        }
+
+        double last = centroids.back().weight / 2;
+        double t = std::min(1.0,(target - cumulative) / last);
+        return centroids.back().mean + (max - centroids.back().mean) * t;
+    }
+
+    inline double tdigest::cdf(double x)
+    {
+        this->compress();
+        if (centroids.empty() || x < min) return 0;
+        if (x >= max) return 1;
+
+        double first = centroids.front().weight / 2;
+        if (x < centroids.front().mean) {
+            double span = centroids.front().mean - min;
+            return span > 0 ? first * (x - min) / span / total : 0;
+        }
+
+        double cumulative = first;
+        for (std::size_t i = 0; i + 1 < centroids.size(); ++i) {
+            double step = (centroids[i].weight + centroids[i+1].weight) / 2;
+            if (x < centroids[i+1].mean) {
+                double span = centroids[i+1].mean - centroids[i].mean;
+                double t = span > 0 ? (x - centroids[i].mean) / span : 1;
+                return (cumulative + step * t) / total;
+            }
+            cumulative += step;
+        }
+
+        double span = max - centroids.back().mean;
+        double last = centroids.back().weight / 2;
+        double t = span > 0 ? (x - centroids.back().mean) / span : 1;
+        return (cumulative + last * t) / total;
+    }
+
+    inline double tdigest::count() const
+    {
+        double buffered = 0;
+        for (auto const &c: buffer) {
+            buffered += c.weight;
+        }
+        return total + buffered;
+    }
+
+    inline std::vector<std::uint8_t> tdigest::serialize()
+    {
+        this->compress();
+
+        std::vector<std::uint8_t> out;
+        out.reserve(1 + 8 * (5 + 2 * centroids.size()));
+        out.push_back('T');
+        put_double(out,compression);
+        put_double(out,min);
+        put_double(out,max);
+        put_word(out,centroids.size());
+        for (auto const &c: centroids) {
+            put_double(out,c.mean);
+            put_double(out,c.weight);
+        }
+        return out;
+    }
+
+    inline tdigest tdigest::deserialize(const std::vector<std::uint8_t> &bytes)
+    {
+        if (bytes.empty() || bytes[0] != 'T') throw "Corrupted sketch";
+
+        std::size_t pos = 1;
+        tdigest digest(get_double(bytes,pos));
+        digest.min = get_double(bytes,pos);
+        digest.max = get_double(bytes,pos);
+        std::uint64_t n = get_word(bytes,pos);
+        if ((bytes.size() - pos) / 16 < n) throw "Corrupted sketch";
+        for (std::uint64_t i = 0; i < n; ++i) {
+            double mean = get_double(bytes,pos);
+            double weight = get_double(bytes,pos);
+            digest.centroids.push_back(centroid{mean,weight});
+            digest.total += weight;
+        }
+        return digest;
+    }
+
+    inline void tdigest::compress()
+    {
+        if (buffer.empty()) return;
+
+        buffer.insert(buffer.end(),centroids.begin(),centroids.end());
+        std::sort(buffer.begin(),buffer.end(),[](const centroid &a, const centroid &b) {
+            return a.mean < b.mean;
+        });
+        for (auto const &c: centroids) {
+            total -= c.weight;
+        }
+        for (auto const &c: buffer) {
+            total += c.weight;
+        }
+        centroids.clear();
+
+        // the scale function k(q) = compression / (2 pi) * asin(2q - 1)
+        // allows each centroid to span one unit of k: the centroids near
+        // q = 0 and q = 1 stay small
+        const double pi = 3.14159265358979323846;
+        auto limit = [this,pi](double q) {
+            double k = compression / (2 * pi) * std::asin(2 * q - 1) + 1;
+            return k >= compression / 4 ? 1.0 : (std::sin(k * 2 * pi / compression) + 1) / 2;
+        };
+
+        centroid current = buffer.front();
+        double before = 0;
+        double q_limit = limit(0);
+        for (std::size_t i = 1; i < buffer.size(); ++i) {
+            const centroid &next = buffer[i];
+            double q = (before + current.weight + next.weight) / total;
+            if (q <= q_limit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            } else {
+                before += current.weight;
+                centroids.push_back(current);
+                q_limit = limit(before / total);
+                current = next;
+            }
+        }
+        centroids.push_back(current);
+        buffer.clear();
+    }
+
+    template <typename T, typename Hash>
+    count_min<T,Hash>::count_min(double epsilon, double delta) : sum(0)
+    {
+        if (epsilon <= 0 || epsilon >= 1) throw "epsilon must be in the range (0,1)";
+        if (delta <= 0 || delta >= 1) throw "delta must be in the range (0,1)";
+
+        width = static_cast<std::size_t>(std::ceil(std::exp(1.0) / epsilon));
+        depth = static_cast<std::size_t>(std::ceil(std::log(1 / delta)));
+        table.assign(width * depth,0);
+    }
+
+    template <typename T, typename Hash>
+    template <typename C, typename>
+    count_min<T,Hash>::count_min(const C &container, double epsilon, double delta)
+        : count_min(epsilon,delta)
+    {
+        sketch_all(*this,container);
+    }
+
+    template <typename T, typename Hash>
+    void count_min<T,Hash>::add(const T &elem, std::uint64_t count)
+    {
+        // the i-th row uses the hash h1 + i * h2
+        std::uint64_t h1 = mix64(static_cast<std::uint64_t>(hasher(elem)));
+        std::uint64_t h2 = mix64(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+        for (std::size_t i = 0; i < depth; ++i) {
+            std::uint64_t g = h1 + i * h2;
+            table[i * width + ((g >> 32) * width >> 32)] += count;
+        }
+        sum += count;
+    }
+
+    template <typename T, typename Hash>
+    void count_min<T,Hash>::merge(const count_min<T,Hash> &other)
+    {
+        if (other.width != width || other.depth != depth)
+            throw "Cannot merge sketches of different sizes";
+
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            table[i] += other.table[i];
+        }
+        sum += other.sum;
+    }
+
+    template <typename T, typename Hash>
+    std::uint64_t count_min<T,Hash>::estimate(const T &elem) const
+    {
+        std::uint64_t h1 = mix64(static_cast<std::uint64_t>(hasher(elem)));
+        std::uint64_t h2 = mix64(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+        std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < depth; ++i) {
+            std::uint64_t g = h1 + i * h2;
+            best = std::min(best,table[i * width + ((g >> 32) * width >> 32)]);
+        }
+        return best;
+    }
+
+    template <typename T, typename Hash>
+    inline std::uint64_t count_min<T,Hash>::total() const { return sum; }
+
+    template <typename T, typename Hash>
+    std::vector<std::uint8_t> count_min<T,Hash>::serialize() const
+    {
+        std::vector<std::uint8_t> out;
+        out.reserve(1 + 8 * (3 + table.size()));
+        out.push_back('C');
+        put_word(out,width);
+        put_word(out,depth);
+        put_word(out,sum);
+        for (auto x: table) {
+            put_word(out,x);
+        }
+        return out;
+    }
+
+    template <typename T, typename Hash>
+    count_min<T,Hash> count_min<T,Hash>::deserialize(const std::vector<std::uint8_t> &bytes)
+    {
+        if (bytes.empty() || bytes[0] != 'C') throw "Corrupted sketch";
+
+        std::size_t pos = 1;
+        count_min<T,Hash> sketch;
+        sketch.width = get_word(bytes,pos);
+        sketch.depth = get_word(bytes,pos);
+        sketch.sum = get_word(bytes,pos);
+        if (sketch.width == 0 || sketch.depth == 0 ||
+            (bytes.size() - pos) / 8 / sketch.width != sketch.depth ||
+            (bytes.size() - pos) % (8 * sketch.width) != 0)
+            throw "Corrupted sketch";
+
+        sketch.table.resize(sketch.width * sketch.depth);
+        for (auto &x: sketch.table) {
+            x = get_word(bytes,pos);
+        }
+        return sketch;
+    }
+}
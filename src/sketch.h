@@ -0,0 +1,203 @@
+/*
+ *  collection/src/sketch.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef sketch_h
+#define sketch_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include "scheduler.h"
+#include "algorithms.h"
+
+/*
+ * The size above which the sketches of a random-access container (e.g.
+ * an fvec) are built in parallel: each thread sketches at least this many
+ * elements, then the partial sketches are merged.
+ */
+#ifndef FNC_PARALLEL_SKETCH_THRESHOLD
+#define FNC_PARALLEL_SKETCH_THRESHOLD 65536
+#endif
+
+namespace fnc {
+
+    /*
+     * The sketches summarize a collection in a small, fixed amount of
+     * memory, answering approximately what the exact operations answer
+     * only with memory proportional to the data:
+     *
+     *     hyperloglog<T>  ~ distinct().size()
+     *     tdigest         ~ the quantiles of sort()
+     *     count_min<T>    ~ the sizes of the groups of group()
+     *
+     * Two sketches with the same parameters can be merged, giving the
+     * sketch of the union of their inputs: the data can be sketched in
+     * pieces, on different threads or machines, and the pieces combined.
+     * `serialize` returns the bytes of a sketch and `deserialize` reads
+     * them back.
+     *
+     * WARNING: the sketches of hyperloglog and count_min from different
+     * processes can only be merged if `Hash` gives the same values in
+     * all of them.
+     */
+
+    /*
+     * `hyperloglog` estimates the number of distinct elements added to
+     * it, with a relative standard error of 1.04 / sqrt(2^precision), in
+     * 2^precision bytes: 0.8% in 16KB with the default precision of 14.
+     *
+     * Example:
+     *
+     *     hyperloglog<std::string> users(visits);
+     *     double distinct_users = users.estimate();
+     */
+    template <typename T, typename Hash = std::hash<T> >
+    class hyperloglog {
+
+    public :
+        /*
+         * - precision : the log2 of the number of registers, in [4,18].
+         */
+        hyperloglog(unsigned precision = 14);
+
+        template <typename C,
+                  typename = decltype(std::begin(std::declval<const C &>()))>
+        hyperloglog(const C &container, unsigned precision = 14);
+
+        void add(const T &elem);
+
+        /*
+         * `merge` adds the elements of `other` to this sketch.
+         */
+        void merge(const hyperloglog<T,Hash> &other);
+
+        double estimate() const;
+
+        inline unsigned precision() const;
+
+        std::vector<std::uint8_t> serialize() const;
+
+        static hyperloglog<T,Hash> deserialize(const std::vector<std::uint8_t> &bytes);
+
+    private :
+        unsigned p;
+        std::vector<std::uint8_t> registers;
+        Hash hasher;
+    };
+
+    /*
+     * `tdigest` estimates the quantiles of the numbers added to it. It
+     * keeps them as a few weighted centroids, small near the extremes and
+     * larger in the middle, so the tail quantiles (p99, p999) are the
+     * most accurate ones. The number of centroids is about `compression`.
+     *
+     * Example:
+     *
+     *     tdigest latencies(samples);
+     *     double p99 = latencies.quantile(0.99);
+     */
+    class tdigest {
+
+    public :
+        tdigest(double compression = 100);
+
+        template <typename C,
+                  typename = decltype(std::begin(std::declval<const C &>()))>
+        tdigest(const C &container, double compression = 100);
+
+        void add(double x, double weight = 1);
+
+        void merge(const tdigest &other);
+
+        /*
+         * `quantile` returns the estimate of the q-quantile, q in [0,1].
+         * WARNING: the digest must not be empty.
+         */
+        double quantile(double q);
+
+        /*
+         * `cdf` returns the estimate of the fraction of the numbers <= x.
+         */
+        double cdf(double x);
+
+        inline double count() const;
+
+        std::vector<std::uint8_t> serialize();
+
+        static tdigest deserialize(const std::vector<std::uint8_t> &bytes);
+
+    private :
+        struct centroid {
+            double mean;
+            double weight;
+        };
+
+        double compression;
+        std::vector<centroid> centroids;
+        std::vector<centroid> buffer;
+        double total;
+        double min;
+        double max;
+
+        /*
+         * `compress` merges the buffered centroids into the digest.
+         */
+        void compress();
+    };
+
+    /*
+     * `count_min` estimates how many times each element was added to it.
+     * An estimate is never below the true count, and exceeds it by at
+     * most epsilon * (the total count) with probability 1 - delta.
+     *
+     * Example:
+     *
+     *     count_min<std::string> words(text, 0.0001);
+     *     std::uint64_t the = words.estimate("the");
+     */
+    template <typename T, typename Hash = std::hash<T> >
+    class count_min {
+
+    public :
+        count_min(double epsilon = 0.001, double delta = 0.01);
+
+        template <typename C,
+                  typename = decltype(std::begin(std::declval<const C &>()))>
+        count_min(const C &container, double epsilon = 0.001, double delta = 0.01);
+
+        void add(const T &elem, std::uint64_t count = 1);
+
+        void merge(const count_min<T,Hash> &other);
+
+        std::uint64_t estimate(const T &elem) const;
+
+        /*
+         * `total` is the sum of the counts added.
+         */
+        inline std::uint64_t total() const;
+
+        std::vector<std::uint8_t> serialize() const;
+
+        static count_min<T,Hash> deserialize(const std::vector<std::uint8_t> &bytes);
+
+    private :
+        std::size_t width;
+        std::size_t depth;
+        std::vector<std::uint64_t> table;
+        std::uint64_t sum;
+        Hash hasher;
+    };
+
+}
+
+#include "sketch.cc"
+
+#endif
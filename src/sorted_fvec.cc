@@ -0,0 +1,271 @@
+/*
+ *  collection/src/sorted_fvec.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <iterator>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp>::sorted_fvec(Cmp cmp) : fvec<T>(), cmp(cmp) {}
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp>::sorted_fvec(fvec<T> vec, Cmp cmp)
+        : fvec<T>(std::move(vec)), cmp(cmp)
+    {
+        if (!std::is_sorted(this->begin(),this->end(),this->cmp))
+            std::stable_sort(this->begin(),this->end(),this->cmp);
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp>::sorted_fvec(fvec<T> vec, Cmp cmp, unchecked)
+        : fvec<T>(std::move(vec)), cmp(cmp) {}
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::assume_sorted(fvec<T> vec, Cmp cmp)
+    {
+        return sorted_fvec<T,Cmp>(std::move(vec),cmp,unchecked());
+    }
+
+    template <typename T, typename Cmp>
+    inline const Cmp &sorted_fvec<T,Cmp>::comparator() const { return cmp; }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::merge(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        res.reserve(this->size() + other.size());
+        std::merge(this->begin(),this->end(),other.begin(),other.end(),std::back_inserter(res),cmp);
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::set_union(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        res.reserve(this->size() + other.size());
+        std::set_union(this->begin(),this->end(),other.begin(),other.end(),std::back_inserter(res),cmp);
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::set_intersection(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        res.reserve(std::min(this->size(),other.size()));
+        std::set_intersection(this->begin(),this->end(),other.begin(),other.end(),
+                              std::back_inserter(res),cmp);
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::set_difference(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        res.reserve(this->size());
+        std::set_difference(this->begin(),this->end(),other.begin(),other.end(),
+                            std::back_inserter(res),cmp);
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::unique()
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        for (auto const &i: *this) {
+            if (res.empty() || cmp(res.back(),i)) res.push_back(i);
+        }
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    fvec<T> sorted_fvec<T,Cmp>::unite(const sorted_fvec<T,Cmp> &other)
+    {
+        fvec<T> res(*this);
+        std::size_t i = 0;
+        for (auto const &j: other) {
+            while (i < this->size() && cmp((*this)[i],j)) ++i;
+            if (i == this->size() || cmp(j,(*this)[i])) res.push_back(j);
+        }
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::intersecate(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        std::size_t i = 0;
+        for (auto const &j: other) {
+            while (i < this->size() && cmp((*this)[i],j)) ++i;
+            if (i < this->size() && !cmp(j,(*this)[i])) res.push_back(j);
+        }
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::except(const sorted_fvec<T,Cmp> &other)
+    {
+        sorted_fvec<T,Cmp> res(cmp);
+        std::size_t j = 0;
+        for (auto const &i: *this) {
+            while (j < other.size() && cmp(other[j],i)) ++j;
+            if (j == other.size() || cmp(i,other[j])) res.push_back(i);
+        }
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    inline sorted_fvec<T,Cmp> sorted_fvec<T,Cmp>::distinct() { return this->unique(); }
+
+    template <typename T, typename Cmp>
+    template <typename U, typename CmpU, typename KA, typename KB>
+    fvec<std::tuple<T,U> > sorted_fvec<T,Cmp>::merge_join_on(const sorted_fvec<U,CmpU> &other,
+                                                            KA key_a, KB key_b)
+    {
+        return this->merge_join_on(other,key_a,key_b,[](const T &x, const U &y) {
+            return std::make_tuple(x,y);
+        });
+    }
+
+    template <typename T, typename Cmp>
+    template <typename U, typename CmpU, typename KA, typename KB, typename P>
+    fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                          std::declval<const U &>()))>::type>
+    sorted_fvec<T,Cmp>::merge_join_on(const sorted_fvec<U,CmpU> &other, KA key_a, KB key_b,
+                                      P project)
+    {
+        typedef typename std::decay<decltype(project(std::declval<const T &>(),
+                                                     std::declval<const U &>()))>::type R;
+
+        fvec<R> res;
+        std::size_t i = 0, j = 0;
+        while (i < this->size() && j < other.size()) {
+            auto ka = key_a((*this)[i]);
+            auto kb = key_b(other[j]);
+            if (ka < kb) {
+                ++i;
+            } else if (kb < ka) {
+                ++j;
+            } else {
+                // the runs of equal keys on both sides, joined pairwise
+                std::size_t i_end = i + 1, j_end = j + 1;
+                while (i_end < this->size() && !(ka < key_a((*this)[i_end]))) ++i_end;
+                while (j_end < other.size() && !(kb < key_b(other[j_end]))) ++j_end;
+                for (std::size_t a = i; a < i_end; ++a) {
+                    for (std::size_t b = j; b < j_end; ++b) {
+                        res.push_back(project((*this)[a],other[b]));
+                    }
+                }
+                i = i_end;
+                j = j_end;
+            }
+        }
+        return res;
+    }
+
+    template <typename T, typename Cmp>
+    loser_tree<T,Cmp>::loser_tree(std::vector<std::pair<const T *, const T *> > runs, Cmp cmp)
+        : runs(std::move(runs)), losers(std::max<std::size_t>(this->runs.size(),1),0), cmp(cmp)
+    {
+        if (!this->runs.empty()) losers[0] = this->play(1);
+    }
+
+    template <typename T, typename Cmp>
+    inline bool loser_tree<T,Cmp>::empty() const
+    {
+        return runs.empty() || runs[losers[0]].first == runs[losers[0]].second;
+    }
+
+    template <typename T, typename Cmp>
+    inline const T &loser_tree<T,Cmp>::top() const { return *runs[losers[0]].first; }
+
+    template <typename T, typename Cmp>
+    inline std::size_t loser_tree<T,Cmp>::top_run() const { return losers[0]; }
+
+    template <typename T, typename Cmp>
+    void loser_tree<T,Cmp>::pop()
+    {
+        std::size_t k = runs.size();
+        std::size_t winner = losers[0];
+        ++runs[winner].first;
+
+        // replay the matches from the leaf of the winner up to the root
+        for (std::size_t node = (winner + k) / 2; node > 0; node /= 2) {
+            if (this->beats(losers[node],winner)) std::swap(losers[node],winner);
+        }
+        losers[0] = winner;
+    }
+
+    template <typename T, typename Cmp>
+    inline bool loser_tree<T,Cmp>::beats(std::size_t a, std::size_t b) const
+    {
+        // an exhausted run loses every match, and ties go to the first run
+        if (runs[a].first == runs[a].second) return false;
+        if (runs[b].first == runs[b].second) return true;
+        if (cmp(*runs[a].first,*runs[b].first)) return true;
+        if (cmp(*runs[b].first,*runs[a].first)) return false;
+        return a < b;
+    }
+
+    template <typename T, typename Cmp>
+    std::size_t loser_tree<T,Cmp>::play(std::size_t node)
+    {
+        // the nodes are numbered as in a heap: the inner ones are [1,k),
+        // and the leaf of the i-th run is k + i
+        std::size_t k = runs.size();
+        if (node >= k) return node - k;
+
+        std::size_t left = this->play(2 * node);
+        std::size_t right = this->play(2 * node + 1);
+        if (this->beats(left,right)) {
+            losers[node] = right;
+            return left;
+        }
+        losers[node] = left;
+        return right;
+    }
+
+    template <typename Cmp>
+    inline Cmp default_comparator(std::true_type) { return Cmp(); }
+
+    template <typename Cmp>
+    inline Cmp default_comparator(std::false_type)
+    {
+        throw "Cannot merge an empty vector of runs without a comparator";
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> merge_all(const std::vector<sorted_fvec<T,Cmp> > &runs)
+    {
+        if (runs.empty())
+            return sorted_fvec<T,Cmp>(default_comparator<Cmp>(std::is_default_constructible<Cmp>()));
+
+        return merge_all(runs,runs[0].comparator());
+    }
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> merge_all(const std::vector<sorted_fvec<T,Cmp> > &runs, Cmp cmp)
+    {
+        std::vector<std::pair<const T *, const T *> > ranges;
+        std::size_t total = 0;
+        for (auto const &r: runs) {
+            ranges.push_back(std::make_pair(r.data(),r.data() + r.size()));
+            total += r.size();
+        }
+
+        sorted_fvec<T,Cmp> res(cmp);
+        if (runs.empty()) return res;
+
+        res.reserve(total);
+        loser_tree<T,Cmp> tree(std::move(ranges),cmp);
+        for (; !tree.empty(); tree.pop()) {
+            res.push_back(tree.top());
+        }
+        return res;
+    }
+}
@@ -0,0 +1,178 @@
+/*
+ *  collection/src/sorted_fvec.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef sorted_fvec_h
+#define sorted_fvec_h
+
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "fvec.h"
+
+namespace fnc {
+
+    /*
+     * `sorted_fvec` is an fvec that records that its elements are sorted
+     * by `Cmp` (std::less<T> by default). It is what `fvec::sort` returns,
+     * and the set operations between sorted_fvecs are linear merges of the
+     * two sequences instead of building a tree or a hash table:
+     *
+     *     auto events = fnc::sorted_fvec<event,by_time>(incoming);
+     *     auto all = events.merge(late_events);
+     *
+     * The set operations follow the multiset semantics of the std
+     * algorithms: an element found m times in this fvec and n times in
+     * `other` is kept max(m,n) times by `set_union`, min(m,n) by
+     * `set_intersection` and max(m-n,0) by `set_difference`. `unite`,
+     * `intersecate`, `except` and `distinct` keep the semantics of fvec,
+     * computed by merging.
+     *
+     * WARNING: `Cmp` must be a strict weak ordering (e.g. (<), not (<=)),
+     * and modifying the elements through the fvec interface (push_back,
+     * operator[], ...) can break the ordering the operations rely on.
+     */
+    template <typename T, typename Cmp>
+    class sorted_fvec : public fvec<T> {
+
+    public :
+        explicit sorted_fvec(Cmp cmp = Cmp());
+
+        /*
+         * Checks that `vec` is sorted in linear time, and sorts it (stably)
+         * if it is not.
+         */
+        explicit sorted_fvec(fvec<T> vec, Cmp cmp = Cmp());
+
+        /*
+         * `assume_sorted` wraps `vec` without checking it: use it only for
+         * data known to be sorted by `cmp`.
+         */
+        static sorted_fvec<T,Cmp> assume_sorted(fvec<T> vec, Cmp cmp = Cmp());
+
+        inline const Cmp &comparator() const;
+
+        /*
+         * `merge` returns all the elements of both fvecs, sorted; equivalent
+         * elements of this fvec come first.
+         */
+        sorted_fvec<T,Cmp> merge(const sorted_fvec<T,Cmp> &other);
+
+        sorted_fvec<T,Cmp> set_union(const sorted_fvec<T,Cmp> &other);
+
+        sorted_fvec<T,Cmp> set_intersection(const sorted_fvec<T,Cmp> &other);
+
+        sorted_fvec<T,Cmp> set_difference(const sorted_fvec<T,Cmp> &other);
+
+        /*
+         * `unique` keeps the first one of each run of equivalent elements.
+         */
+        sorted_fvec<T,Cmp> unique();
+
+        using fvec<T>::unite;
+        using fvec<T>::intersecate;
+        using fvec<T>::except;
+
+        /*
+         * `unite`, `intersecate`, `except` and `distinct` give the same
+         * results as the ones of fvec, with elements compared through
+         * `Cmp`, but find the matches by walking both fvecs once:
+         *
+         * - unite : this fvec, then the elements of `other` that are not
+         *   in it (so the result is an fvec, not sorted as a whole);
+         * - intersecate : the elements of `other` that are in this fvec;
+         * - except : the elements of this fvec that are not in `other`;
+         * - distinct : the first one of each run of equivalent elements.
+         */
+        fvec<T> unite(const sorted_fvec<T,Cmp> &other);
+
+        sorted_fvec<T,Cmp> intersecate(const sorted_fvec<T,Cmp> &other);
+
+        sorted_fvec<T,Cmp> except(const sorted_fvec<T,Cmp> &other);
+
+        inline sorted_fvec<T,Cmp> distinct();
+
+        /*
+         * `merge_join_on` is the inner join of this fvec with `other` on
+         * key_a(x) == key_b(y), as `fvec::join_on`, but it walks both fvecs
+         * once instead of building a hash table. The pairs come sorted by
+         * key; for equal keys, in the order of this fvec, then of `other`.
+         *
+         * WARNING: both fvecs must be sorted by their keys in increasing
+         * order of (<), e.g. sorted by timestamp and joined on it.
+         */
+        template <typename U, typename CmpU, typename KA, typename KB>
+        fvec<std::tuple<T,U> > merge_join_on(const sorted_fvec<U,CmpU> &other, KA key_a, KB key_b);
+
+        template <typename U, typename CmpU, typename KA, typename KB, typename P>
+        fvec<typename std::decay<decltype(std::declval<P &>()(std::declval<const T &>(),
+                                                              std::declval<const U &>()))>::type>
+        merge_join_on(const sorted_fvec<U,CmpU> &other, KA key_a, KB key_b, P project);
+
+    private :
+        Cmp cmp;
+
+        struct unchecked {};
+
+        sorted_fvec(fvec<T> vec, Cmp cmp, unchecked);
+    };
+
+    /*
+     * `loser_tree` merges k sorted runs, popping their elements in order
+     * with about log2(k) comparisons each: every inner node of the tree
+     * holds the run that lost the match played there, so replacing the
+     * winner only replays the matches on its path to the root. Equivalent
+     * elements come out in the order of their runs.
+     */
+    template <typename T, typename Cmp>
+    class loser_tree {
+
+    public :
+        loser_tree(std::vector<std::pair<const T *, const T *> > runs, Cmp cmp);
+
+        inline bool empty() const;
+
+        inline const T &top() const;
+
+        /*
+         * `top_run` is the index of the run holding `top`.
+         */
+        inline std::size_t top_run() const;
+
+        void pop();
+
+    private :
+        std::vector<std::pair<const T *, const T *> > runs;
+        std::vector<std::size_t> losers;
+        Cmp cmp;
+
+        inline bool beats(std::size_t a, std::size_t b) const;
+
+        std::size_t play(std::size_t node);
+    };
+
+    /*
+     * `merge_all` is the k-way merge of `runs` through a loser tree: all
+     * their elements, sorted, in a single pass. The result is sorted by
+     * `cmp`, or by the comparator of the first run. No runs give an empty
+     * sorted_fvec; when `Cmp` has no default constructor (a lambda), pass
+     * `cmp` for that case.
+     */
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> merge_all(const std::vector<sorted_fvec<T,Cmp> > &runs);
+
+    template <typename T, typename Cmp>
+    sorted_fvec<T,Cmp> merge_all(const std::vector<sorted_fvec<T,Cmp> > &runs, Cmp cmp);
+
+}
+
+#include "sorted_fvec.cc"
+
+#endif
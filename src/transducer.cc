@@ -0,0 +1,247 @@
+/*
+ *  collection/src/transducer.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+namespace fnc {
+
+    /*
+     * The step functions built by `apply`: each one takes an element of
+     * type In and returns false when the pass must stop.
+     */
+    template <typename In, typename F, typename Step>
+    struct mapping_step {
+        F f;
+        Step next;
+
+        inline bool operator()(const In &x) { return next(f(x)); }
+    };
+
+    template <typename In, typename P, typename Step>
+    struct filtering_step {
+        P predicate;
+        Step next;
+
+        inline bool operator()(const In &x) { return !predicate(x) || next(x); }
+    };
+
+    template <typename In, typename P, typename Step>
+    struct taking_while_step {
+        P predicate;
+        Step next;
+
+        inline bool operator()(const In &x) { return predicate(x) && next(x); }
+    };
+
+    template <typename In, typename Step>
+    struct taking_step {
+        std::size_t left;
+        Step next;
+
+        inline bool operator()(const In &x)
+        {
+            if (left == 0) return false;
+            return next(x) && --left > 0;
+        }
+    };
+
+    template <typename In, typename Step>
+    struct dropping_step {
+        std::size_t left;
+        Step next;
+
+        inline bool operator()(const In &x)
+        {
+            if (left > 0) {
+                left--;
+                return true;
+            }
+            return next(x);
+        }
+    };
+
+    template <typename In, typename Step>
+    struct deduping_step {
+        bool seen;
+        typename std::aligned_storage<sizeof(In),alignof(In)>::type last;
+        Step next;
+
+        deduping_step(Step next) : seen(false), next(next) {}
+
+        deduping_step(const deduping_step &other) : seen(other.seen), next(other.next)
+        {
+            if (seen) new (&last) In(other.previous());
+        }
+
+        deduping_step &operator=(const deduping_step &other) = delete;
+
+        ~deduping_step()
+        {
+            if (seen) previous().~In();
+        }
+
+        inline const In &previous() const { return *reinterpret_cast<const In *>(&last); }
+
+        bool operator()(const In &x)
+        {
+            if (seen) {
+                if (previous() == x) return true;
+                *reinterpret_cast<In *>(&last) = x;
+            } else {
+                new (&last) In(x);
+                seen = true;
+            }
+            return next(x);
+        }
+    };
+
+    template <typename F>
+    mapping_t<F>::mapping_t(F f) : f(f) {}
+
+    template <typename F>
+    template <typename In, typename Step>
+    auto mapping_t<F>::apply(Step step) const
+    {
+        return mapping_step<In,F,Step>{f,step};
+    }
+
+    template <typename P>
+    filtering_t<P>::filtering_t(P predicate) : predicate(predicate) {}
+
+    template <typename P>
+    template <typename In, typename Step>
+    auto filtering_t<P>::apply(Step step) const
+    {
+        return filtering_step<In,P,Step>{predicate,step};
+    }
+
+    template <typename P>
+    taking_while_t<P>::taking_while_t(P predicate) : predicate(predicate) {}
+
+    template <typename P>
+    template <typename In, typename Step>
+    auto taking_while_t<P>::apply(Step step) const
+    {
+        return taking_while_step<In,P,Step>{predicate,step};
+    }
+
+    inline taking_t::taking_t(std::size_t n) : n(n) {}
+
+    template <typename In, typename Step>
+    auto taking_t::apply(Step step) const
+    {
+        return taking_step<In,Step>{n,step};
+    }
+
+    inline dropping_t::dropping_t(std::size_t n) : n(n) {}
+
+    template <typename In, typename Step>
+    auto dropping_t::apply(Step step) const
+    {
+        return dropping_step<In,Step>{n,step};
+    }
+
+    template <typename In, typename Step>
+    auto deduping_t::apply(Step step) const
+    {
+        return deduping_step<In,Step>(step);
+    }
+
+    template <typename A, typename B>
+    composed_t<A,B>::composed_t(A a, B b) : a(a), b(b) {}
+
+    template <typename A, typename B>
+    template <typename In, typename Step>
+    auto composed_t<A,B>::apply(Step step) const
+    {
+        typedef typename A::template output<In>::type middle;
+        return a.template apply<In>(b.template apply<middle>(step));
+    }
+
+    template <typename F>
+    mapping_t<F> mapping(F f) { return mapping_t<F>(f); }
+
+    template <typename P>
+    filtering_t<P> filtering(P predicate) { return filtering_t<P>(predicate); }
+
+    inline taking_t taking(std::size_t n) { return taking_t(n); }
+
+    template <typename P>
+    taking_while_t<P> taking_while(P predicate) { return taking_while_t<P>(predicate); }
+
+    inline dropping_t dropping(std::size_t n) { return dropping_t(n); }
+
+    inline deduping_t deduping() { return deduping_t(); }
+
+    template <typename A, typename B, typename>
+    composed_t<A,B> operator|(A a, B b) { return composed_t<A,B>(a,b); }
+
+    template <typename X, typename It, typename Action>
+    void run(X xf, It first, It last, Action action)
+    {
+        typedef typename std::iterator_traits<It>::value_type In;
+        typedef typename X::template output<In>::type Out;
+
+        auto step = xf.template apply<In>([&action](const Out &y) {
+            action(y);
+            return true;
+        });
+        for (; first != last; ++first) {
+            if (!step(*first)) break;
+        }
+    }
+
+    template <typename X, typename R, typename Action>
+    void run(X xf, const R &range, Action action)
+    {
+        run(xf,std::begin(range),std::end(range),action);
+    }
+
+    template <typename X, typename F, typename T, typename It>
+    T transduce(X xf, F f, T base, It first, It last)
+    {
+        typedef typename std::iterator_traits<It>::value_type In;
+        typedef typename X::template output<In>::type Out;
+
+        T acc = base;
+        auto step = xf.template apply<In>([&acc,&f](const Out &y) {
+            acc = f(acc,y);
+            return true;
+        });
+        for (; first != last; ++first) {
+            if (!step(*first)) break;
+        }
+        return acc;
+    }
+
+    template <typename X, typename F, typename T, typename R>
+    T transduce(X xf, F f, T base, const R &range)
+    {
+        return transduce(xf,f,base,std::begin(range),std::end(range));
+    }
+
+    template <typename C, typename X, typename It>
+    C into(C to, X xf, It first, It last)
+    {
+        typedef typename std::iterator_traits<It>::value_type In;
+        typedef typename X::template output<In>::type Out;
+
+        auto step = xf.template apply<In>([&to](const Out &y) {
+            to.insert(to.end(),y);
+            return true;
+        });
+        for (; first != last; ++first) {
+            if (!step(*first)) break;
+        }
+        return to;
+    }
+
+    template <typename C, typename X, typename R>
+    C into(C to, X xf, const R &range)
+    {
+        return into(to,xf,std::begin(range),std::end(range));
+    }
+}
@@ -0,0 +1,240 @@
+/*
+ *  collection/src/transducer.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef transducer_h
+#define transducer_h
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+namespace fnc {
+
+    /*
+     * Transducers are container-agnostic operators: they describe what to
+     * do with each element, independently from where the elements come
+     * from and where the results go.
+     *
+     *     auto xf = mapping([](int x) { return x * x; })
+     *             | filtering([](int x) { return x % 2 == 0; })
+     *             | taking(10);
+     *
+     *     fvec<int> v = into(fvec<int>(), xf, some_flist);
+     *     int s = transduce(xf, [](int acc, int x) { return acc + x; }, 0, some_fset);
+     *     run(xf, first, last, [](int x) { std::cout << x; });
+     *
+     * The composed operators run in a single pass over the input, without
+     * intermediate containers and without type erasure: `apply<In>` wraps
+     * a step function (a callable returning false to stop the pass) into
+     * another one, and all the steps are inlined into the loop.
+     *
+     * A transducer `X` provides
+     *
+     *     template <typename In> struct output { typedef ... type; };
+     *     template <typename In, typename Step> auto apply(Step step) const;
+     *
+     * and derives from `transducer_tag`, to be composable with (|).
+     */
+    struct transducer_tag {};
+
+    template <typename F>
+    class mapping_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef typename std::decay<decltype(std::declval<F &>()(std::declval<const In &>()))>::type type;
+        };
+
+        mapping_t(F f);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        F f;
+    };
+
+    template <typename P>
+    class filtering_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef In type;
+        };
+
+        filtering_t(P predicate);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        P predicate;
+    };
+
+    template <typename P>
+    class taking_while_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef In type;
+        };
+
+        taking_while_t(P predicate);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        P predicate;
+    };
+
+    class taking_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef In type;
+        };
+
+        taking_t(std::size_t n);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        std::size_t n;
+    };
+
+    class dropping_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef In type;
+        };
+
+        dropping_t(std::size_t n);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        std::size_t n;
+    };
+
+    class deduping_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef In type;
+        };
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+    };
+
+    /*
+     * `composed_t` runs `A` and then `B`.
+     */
+    template <typename A, typename B>
+    class composed_t : public transducer_tag {
+
+    public :
+        template <typename In>
+        struct output {
+            typedef typename B::template output<typename A::template output<In>::type>::type type;
+        };
+
+        composed_t(A a, B b);
+
+        template <typename In, typename Step>
+        auto apply(Step step) const;
+
+    private :
+        A a;
+        B b;
+    };
+
+    /*
+     * `mapping` applies `f` to each element.
+     */
+    template <typename F>
+    mapping_t<F> mapping(F f);
+
+    /*
+     * `filtering` keeps the elements that fullfill the predicate.
+     */
+    template <typename P>
+    filtering_t<P> filtering(P predicate);
+
+    /*
+     * `taking` stops the pass after n elements, `taking_while` at the
+     * first element that does not fullfill the predicate.
+     */
+    inline taking_t taking(std::size_t n);
+
+    template <typename P>
+    taking_while_t<P> taking_while(P predicate);
+
+    /*
+     * `dropping` skips the first n elements.
+     */
+    inline dropping_t dropping(std::size_t n);
+
+    /*
+     * `deduping` drops the elements equal to the previous one.
+     * WARNING: T must implement the operator (==)
+     */
+    inline deduping_t deduping();
+
+    template <typename A, typename B,
+              typename = typename std::enable_if<std::is_base_of<transducer_tag,A>::value &&
+                                                 std::is_base_of<transducer_tag,B>::value>::type>
+    composed_t<A,B> operator|(A a, B b);
+
+    /*
+     * `run` passes each result to `action`.
+     */
+    template <typename X, typename It, typename Action>
+    void run(X xf, It first, It last, Action action);
+
+    template <typename X, typename R, typename Action>
+    void run(X xf, const R &range, Action action);
+
+    /*
+     * `transduce` folds the results from the left:
+     *
+     *     f(... f(f(base, y1), y2) ..., yn)
+     */
+    template <typename X, typename F, typename T, typename It>
+    T transduce(X xf, F f, T base, It first, It last);
+
+    template <typename X, typename F, typename T, typename R>
+    T transduce(X xf, F f, T base, const R &range);
+
+    /*
+     * `into` appends the results to the container `to` (an fvec, an flist,
+     * an fset, or any container with insert(end,value)) and returns it.
+     */
+    template <typename C, typename X, typename It>
+    C into(C to, X xf, It first, It last);
+
+    template <typename C, typename X, typename R>
+    C into(C to, X xf, const R &range);
+
+}
+
+#include "transducer.cc"
+
+#endif
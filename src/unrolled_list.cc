@@ -0,0 +1,517 @@
+/*
+ *  collection/src/unrolled_list.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <new>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename T>
+    const std::size_t unrolled_list<T>::block_size;
+
+    template <typename T>
+    unrolled_list<T>::unrolled_list() : length(0) { reset_header(); }
+
+    template <typename T>
+    template <typename It, typename>
+    unrolled_list<T>::unrolled_list(It first, It last) : length(0)
+    {
+        reset_header();
+        for (; first != last; ++first) {
+            this->push_back(*first);
+        }
+    }
+
+    template <typename T>
+    unrolled_list<T>::unrolled_list(std::initializer_list<T> l)
+        : unrolled_list(l.begin(),l.end()) {}
+
+    template <typename T>
+    unrolled_list<T>::unrolled_list(const unrolled_list<T> &other)
+        : unrolled_list(other.begin(),other.end()) {}
+
+    template <typename T>
+    unrolled_list<T>::unrolled_list(unrolled_list<T> &&other) : length(0)
+    {
+        reset_header();
+        this->swap(other);
+    }
+
+    template <typename T>
+    unrolled_list<T>::~unrolled_list() { this->clear(); }
+
+    template <typename T>
+    unrolled_list<T> &unrolled_list<T>::operator=(unrolled_list<T> other)
+    {
+        this->swap(other);
+        return *this;
+    }
+
+    template <typename T>
+    inline typename unrolled_list<T>::iterator unrolled_list<T>::begin()
+    {
+        return iterator(header.next,0);
+    }
+
+    template <typename T>
+    inline typename unrolled_list<T>::iterator unrolled_list<T>::end()
+    {
+        return iterator(&header,0);
+    }
+
+    template <typename T>
+    inline typename unrolled_list<T>::const_iterator unrolled_list<T>::begin() const
+    {
+        return const_iterator(header.next,0);
+    }
+
+    template <typename T>
+    inline typename unrolled_list<T>::const_iterator unrolled_list<T>::end() const
+    {
+        return const_iterator(const_cast<node_base *>(&header),0);
+    }
+
+    template <typename T>
+    inline std::size_t unrolled_list<T>::size() const { return length; }
+
+    template <typename T>
+    inline bool unrolled_list<T>::empty() const { return length == 0; }
+
+    template <typename T>
+    inline T &unrolled_list<T>::front() { return *this->begin(); }
+
+    template <typename T>
+    inline T &unrolled_list<T>::back() { return *(--this->end()); }
+
+    template <typename T>
+    inline const T &unrolled_list<T>::front() const { return *this->begin(); }
+
+    template <typename T>
+    inline const T &unrolled_list<T>::back() const { return *(--this->end()); }
+
+    template <typename T>
+    void unrolled_list<T>::push_back(const T &value)
+    {
+        node_base *tail = header.prev;
+
+        if (tail == &header || tail->count == block_size) {
+            node *n = new_node();
+            try {
+                new (n->data()) T(value);
+            } catch (...) {
+                free_node(n);
+                throw;
+            }
+            n->count = 1;
+            link_after(header.prev,n);
+        } else {
+            new (static_cast<node *>(tail)->data() + tail->count) T(value);
+            tail->count++;
+        }
+        length++;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::push_front(const T &value)
+    {
+        this->insert(this->begin(),value);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::pop_back()
+    {
+        this->erase(--this->end());
+    }
+
+    template <typename T>
+    void unrolled_list<T>::pop_front()
+    {
+        this->erase(this->begin());
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::iterator unrolled_list<T>::insert(const_iterator pos, const T &value)
+    {
+        node_base *n = pos.n;
+        std::size_t i = pos.i;
+
+        if (n == &header) {
+            this->push_back(value);
+            return iterator(header.prev,header.prev->count - 1);
+        }
+
+        // `value` may live in the block that is about to be shifted
+        T copy(value);
+
+        if (n->count == block_size) {
+            if (i == 0 && n->prev != &header && n->prev->count < block_size) {
+                // there is room at the end of the previous block
+                n = n->prev;
+                i = n->count;
+            } else {
+                node_base *m = split(n,block_size / 2);
+                if (i > n->count) {
+                    i -= n->count;
+                    n = m;
+                }
+            }
+        }
+
+        T *data = static_cast<node *>(n)->data();
+        if (i == n->count) {
+            new (data + i) T(std::move(copy));
+        } else {
+            new (data + n->count) T(std::move(data[n->count - 1]));
+            std::move_backward(data + i,data + n->count - 1,data + n->count);
+            data[i] = std::move(copy);
+        }
+        n->count++;
+        length++;
+        return iterator(n,i);
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::iterator unrolled_list<T>::erase(const_iterator pos)
+    {
+        node_base *n = pos.n;
+        std::size_t i = pos.i;
+        T *data = static_cast<node *>(n)->data();
+
+        std::move(data + i + 1,data + n->count,data + i);
+        data[n->count - 1].~T();
+        n->count--;
+        length--;
+
+        if (n->count == 0) {
+            node_base *next = n->next;
+            unlink(n);
+            free_node(n);
+            return iterator(next,0);
+        }
+
+        maybe_merge(n);
+        return normalize(n,i);
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::iterator unrolled_list<T>::erase(const_iterator first, const_iterator last)
+    {
+        node_base *fn = first.n;
+        node_base *ln = last.n;
+        if (first == last) return iterator(ln,last.i);
+
+        if (fn == ln) {
+            // a run inside one block: shift its tail down once
+            T *data = static_cast<node *>(fn)->data();
+            std::size_t k = last.i - first.i;
+            std::move(data + last.i,data + fn->count,data + first.i);
+            for (std::size_t j = fn->count - k; j < fn->count; ++j) {
+                data[j].~T();
+            }
+            fn->count -= k;
+            length -= k;
+            maybe_merge(fn);
+            return normalize(fn,first.i);
+        }
+
+        // the tail of the first block, the whole blocks in between, and
+        // the head of the last block
+        T *data = static_cast<node *>(fn)->data();
+        for (std::size_t j = first.i; j < fn->count; ++j) {
+            data[j].~T();
+        }
+        length -= fn->count - first.i;
+        fn->count = first.i;
+
+        for (node_base *n = fn->next; n != ln; ) {
+            node_base *next = n->next;
+            data = static_cast<node *>(n)->data();
+            for (std::size_t j = 0; j < n->count; ++j) {
+                data[j].~T();
+            }
+            length -= n->count;
+            unlink(n);
+            free_node(n);
+            n = next;
+        }
+
+        if (ln != &header && last.i > 0) {
+            data = static_cast<node *>(ln)->data();
+            std::move(data + last.i,data + ln->count,data);
+            for (std::size_t j = ln->count - last.i; j < ln->count; ++j) {
+                data[j].~T();
+            }
+            ln->count -= last.i;
+            length -= last.i;
+        }
+
+        if (fn->count == 0) {
+            unlink(fn);
+            free_node(fn);
+            fn = ln->prev;
+        }
+        if (fn == &header) return iterator(ln,0);
+
+        std::size_t at = fn->count;
+        maybe_merge(fn);
+        return normalize(fn,at);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::clear()
+    {
+        node_base *n = header.next;
+        while (n != &header) {
+            node_base *next = n->next;
+            T *data = static_cast<node *>(n)->data();
+            for (std::size_t i = 0; i < n->count; ++i) {
+                data[i].~T();
+            }
+            free_node(n);
+            n = next;
+        }
+        reset_header();
+        length = 0;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::swap(unrolled_list<T> &other)
+    {
+        node_base *next = header.next;
+        node_base *prev = header.prev;
+        bool was_empty = next == &header;
+
+        if (other.header.next == &other.header) {
+            reset_header();
+        } else {
+            header.next = other.header.next;
+            header.prev = other.header.prev;
+            header.next->prev = &header;
+            header.prev->next = &header;
+        }
+
+        if (was_empty) {
+            other.reset_header();
+        } else {
+            other.header.next = next;
+            other.header.prev = prev;
+            next->prev = &other.header;
+            prev->next = &other.header;
+        }
+
+        std::swap(length,other.length);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::splice(const_iterator pos, unrolled_list<T> &other)
+    {
+        this->splice(pos,other,other.begin(),other.end());
+    }
+
+    template <typename T>
+    void unrolled_list<T>::splice(const_iterator pos, unrolled_list<T> &&other)
+    {
+        this->splice(pos,other,other.begin(),other.end());
+    }
+
+    template <typename T>
+    void unrolled_list<T>::splice(const_iterator pos, unrolled_list<T> &other, const_iterator it)
+    {
+        const_iterator last = it;
+        this->splice(pos,other,it,++last);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::splice(const_iterator pos, unrolled_list<T> &other,
+                                  const_iterator first, const_iterator last)
+    {
+        if (first == last) return;
+
+        bool whole = first == other.begin() && last == other.end();
+        node_base *p = pos.n;
+        std::size_t pi = pos.i;
+
+        // cut the blocks of `other` so that [first,last) is made of whole
+        // blocks, keeping `pos` valid when splicing within the same list
+        node_base *ln = last.n;
+        if (last.i != 0) {
+            node_base *m = other.split(ln,last.i);
+            if (p == ln && pi >= last.i) {
+                p = m;
+                pi -= last.i;
+            }
+            ln = m;
+        }
+        node_base *fn = first.n;
+        if (first.i != 0) {
+            node_base *m = other.split(fn,first.i);
+            if (p == fn && pi >= first.i) {
+                p = m;
+                pi -= first.i;
+            }
+            fn = m;
+        }
+
+        node_base *chain_last = ln->prev;
+        std::size_t moved = 0;
+        if (whole) {
+            moved = other.length;
+        } else {
+            for (node_base *n = fn; n != ln; n = n->next) {
+                moved += n->count;
+            }
+        }
+
+        fn->prev->next = ln;
+        ln->prev = fn->prev;
+        other.length -= moved;
+
+        node_base *after = p->prev;
+        if (p != &header && pi != 0) {
+            split(p,pi);
+            after = p;
+        }
+
+        after->next->prev = chain_last;
+        chain_last->next = after->next;
+        after->next = fn;
+        fn->prev = after;
+        length += moved;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::reverse()
+    {
+        node_base *n = &header;
+        do {
+            std::swap(n->prev,n->next);
+            if (n != &header) {
+                T *data = static_cast<node *>(n)->data();
+                std::reverse(data,data + n->count);
+            }
+            n = n->prev;
+        } while (n != &header);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::sort(std::function<bool(T,T)> comparator)
+    {
+        std::vector<T> buffer;
+        buffer.reserve(length);
+        for (auto &i: *this) {
+            buffer.push_back(std::move(i));
+        }
+
+        std::stable_sort(buffer.begin(),buffer.end(),comparator);
+
+        auto j = buffer.begin();
+        for (auto &i: *this) {
+            i = std::move(*j++);
+        }
+    }
+
+    template <typename T>
+    void unrolled_list<T>::sort()
+    {
+        this->sort([](T x, T y) { return x < y; });
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::node *unrolled_list<T>::new_node()
+    {
+        node *n = new node;
+        n->prev = n->next = nullptr;
+        n->count = 0;
+        return n;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::free_node(node_base *n)
+    {
+        delete static_cast<node *>(n);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::link_after(node_base *at, node_base *n)
+    {
+        n->prev = at;
+        n->next = at->next;
+        at->next->prev = n;
+        at->next = n;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::unlink(node_base *n)
+    {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::node_base *unrolled_list<T>::split(node_base *n, std::size_t i)
+    {
+        node *m = new_node();
+        T *from = static_cast<node *>(n)->data();
+        T *to = m->data();
+
+        for (std::size_t j = i; j < n->count; ++j) {
+            new (to + j - i) T(std::move(from[j]));
+            from[j].~T();
+        }
+        m->count = n->count - i;
+        n->count = i;
+        link_after(n,m);
+        return m;
+    }
+
+    template <typename T>
+    void unrolled_list<T>::maybe_merge(node_base *n)
+    {
+        node_base *next = n->next;
+        if (next == &header || n->count + next->count > block_size / 2) return;
+
+        // keep the blocks at least a quarter full on average
+        T *to = static_cast<node *>(n)->data() + n->count;
+        T *from = static_cast<node *>(next)->data();
+        for (std::size_t j = 0; j < next->count; ++j) {
+            new (to + j) T(std::move(from[j]));
+            from[j].~T();
+        }
+        n->count += next->count;
+        unlink(next);
+        free_node(next);
+    }
+
+    template <typename T>
+    void unrolled_list<T>::reset_header()
+    {
+        header.prev = header.next = &header;
+        header.count = 0;
+    }
+
+    template <typename T>
+    typename unrolled_list<T>::iterator unrolled_list<T>::normalize(node_base *n, std::size_t i)
+    {
+        if (i < n->count) return iterator(n,i);
+        return iterator(n->next,0);
+    }
+
+    template <typename T>
+    bool operator==(const unrolled_list<T> &a, const unrolled_list<T> &b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(),a.end(),b.begin());
+    }
+
+    template <typename T>
+    bool operator!=(const unrolled_list<T> &a, const unrolled_list<T> &b)
+    {
+        return !(a == b);
+    }
+}
@@ -0,0 +1,238 @@
+/*
+ *  collection/src/unrolled_list.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef unrolled_list_h
+#define unrolled_list_h
+
+#include <cstddef>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#include <initializer_list>
+
+namespace fnc {
+
+    /*
+     * `unrolled_list` is a doubly linked list whose nodes hold a block of
+     * up to `block_size` contiguous elements, instead of a single one.
+     *
+     * It offers the subset of the std::list interface used by `flist`, so
+     * that it can be plugged in as its storage:
+     *
+     *     flist<int, unrolled_list> l = ...;
+     *
+     * Scans touch one node per block, so `map`, `filter`, `foldl` and
+     * `sum` run at close to vector speed, while inserting or erasing in
+     * the middle only moves the elements of one block. Splicing a whole
+     * list is O(1) at a block boundary and O(block_size) elsewhere.
+     *
+     * WARNING: unlike std::list, `insert` and `erase` invalidate the
+     * iterators pointing into the block they touch.
+     */
+    template <typename T>
+    class unrolled_list {
+
+    public :
+        static const std::size_t block_size = sizeof(T) >= 64 ? 8 : 512 / sizeof(T);
+
+    private :
+        struct node_base {
+            node_base *prev;
+            node_base *next;
+            std::size_t count;
+        };
+
+        struct node : node_base {
+            typename std::aligned_storage<sizeof(T),alignof(T)>::type storage[block_size];
+
+            inline T *data() { return reinterpret_cast<T *>(storage); }
+        };
+
+    public :
+        template <bool Const>
+        class basic_iterator {
+
+        public :
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef typename std::conditional<Const,const T *,T *>::type pointer;
+            typedef typename std::conditional<Const,const T &,T &>::type reference;
+
+            basic_iterator() : n(nullptr), i(0) {}
+
+            template <bool C, typename = typename std::enable_if<Const && !C>::type>
+            basic_iterator(const basic_iterator<C> &other) : n(other.n), i(other.i) {}
+
+            inline reference operator*() const { return static_cast<node *>(n)->data()[i]; }
+
+            inline pointer operator->() const { return static_cast<node *>(n)->data() + i; }
+
+            inline basic_iterator &operator++()
+            {
+                if (++i == n->count) {
+                    n = n->next;
+                    i = 0;
+                }
+                return *this;
+            }
+
+            inline basic_iterator operator++(int)
+            {
+                basic_iterator old(*this);
+                ++(*this);
+                return old;
+            }
+
+            inline basic_iterator &operator--()
+            {
+                if (i == 0) {
+                    n = n->prev;
+                    i = n->count;
+                }
+                --i;
+                return *this;
+            }
+
+            inline basic_iterator operator--(int)
+            {
+                basic_iterator old(*this);
+                --(*this);
+                return old;
+            }
+
+            inline bool operator==(const basic_iterator &other) const
+            {
+                return n == other.n && i == other.i;
+            }
+
+            inline bool operator!=(const basic_iterator &other) const
+            {
+                return !(*this == other);
+            }
+
+        private :
+            friend class unrolled_list<T>;
+            template <bool> friend class basic_iterator;
+
+            node_base *n;
+            std::size_t i;
+
+            basic_iterator(node_base *n, std::size_t i) : n(n), i(i) {}
+        };
+
+        typedef T value_type;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef basic_iterator<false> iterator;
+        typedef basic_iterator<true> const_iterator;
+
+        unrolled_list();
+
+        template <typename It,
+                  typename = typename std::iterator_traits<It>::iterator_category>
+        unrolled_list(It first, It last);
+
+        unrolled_list(std::initializer_list<T> l);
+
+        unrolled_list(const unrolled_list<T> &other);
+
+        unrolled_list(unrolled_list<T> &&other);
+
+        ~unrolled_list();
+
+        unrolled_list<T> &operator=(unrolled_list<T> other);
+
+        inline iterator begin();
+        inline iterator end();
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
+
+        inline std::size_t size() const;
+        inline bool empty() const;
+
+        inline T &front();
+        inline T &back();
+        inline const T &front() const;
+        inline const T &back() const;
+
+        void push_back(const T &value);
+        void push_front(const T &value);
+        void pop_back();
+        void pop_front();
+
+        iterator insert(const_iterator pos, const T &value);
+        iterator erase(const_iterator pos);
+
+        /*
+         * `erase` of a range frees the blocks it covers whole, and moves
+         * elements only in the blocks at its two ends.
+         */
+        iterator erase(const_iterator first, const_iterator last);
+
+        void clear();
+        void swap(unrolled_list<T> &other);
+
+        /*
+         * `splice` moves all the elements of `other` before `pos`.
+         * Whole blocks are relinked: no element is copied, except for the
+         * block of `pos` that is split in two when `pos` is in its middle.
+         */
+        void splice(const_iterator pos, unrolled_list<T> &other);
+        void splice(const_iterator pos, unrolled_list<T> &&other);
+
+        /*
+         * `splice` moves the element `it` of `other` before `pos`.
+         */
+        void splice(const_iterator pos, unrolled_list<T> &other, const_iterator it);
+
+        /*
+         * `splice` moves the range [first,last) of `other` before `pos`.
+         */
+        void splice(const_iterator pos, unrolled_list<T> &other,
+                    const_iterator first, const_iterator last);
+
+        /*
+         * `reverse` reverses the order of the blocks and of the elements
+         * inside each of them, without allocating.
+         */
+        void reverse();
+
+        /*
+         * `sort` sorts the elements (stably) through a contiguous buffer.
+         */
+        void sort(std::function<bool(T,T)> comparator);
+        void sort();
+
+    private :
+        node_base header;
+        std::size_t length;
+
+        node *new_node();
+        void free_node(node_base *n);
+        void link_after(node_base *at, node_base *n);
+        void unlink(node_base *n);
+        node_base *split(node_base *n, std::size_t i);
+        void maybe_merge(node_base *n);
+        void reset_header();
+        iterator normalize(node_base *n, std::size_t i);
+    };
+
+    template <typename T>
+    bool operator==(const unrolled_list<T> &a, const unrolled_list<T> &b);
+
+    template <typename T>
+    bool operator!=(const unrolled_list<T> &a, const unrolled_list<T> &b);
+
+}
+
+#include "unrolled_list.cc"
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ *  collection/src/zip.cc
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#include <algorithm>
+
+namespace fnc {
+
+    template <typename... Cs>
+    zip_view<Cs...>::iterator::iterator(iterators its) : its(its) {}
+
+    template <typename... Cs>
+    inline typename zip_view<Cs...>::reference zip_view<Cs...>::iterator::operator*() const
+    {
+        return this->get(std::index_sequence_for<Cs...>());
+    }
+
+    template <typename... Cs>
+    inline typename zip_view<Cs...>::iterator &zip_view<Cs...>::iterator::operator++()
+    {
+        this->advance(std::index_sequence_for<Cs...>());
+        return *this;
+    }
+
+    template <typename... Cs>
+    inline typename zip_view<Cs...>::iterator zip_view<Cs...>::iterator::operator++(int)
+    {
+        iterator old(*this);
+        this->advance(std::index_sequence_for<Cs...>());
+        return old;
+    }
+
+    template <typename... Cs>
+    inline bool zip_view<Cs...>::iterator::operator==(const iterator &other) const
+    {
+        return this->any_equal(other,std::index_sequence_for<Cs...>());
+    }
+
+    template <typename... Cs>
+    inline bool zip_view<Cs...>::iterator::operator!=(const iterator &other) const
+    {
+        return !(*this == other);
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline typename zip_view<Cs...>::reference zip_view<Cs...>::iterator::get(std::index_sequence<I...>) const
+    {
+        return reference(*std::get<I>(its)...);
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline void zip_view<Cs...>::iterator::advance(std::index_sequence<I...>)
+    {
+        int expand[] = { 0, (++std::get<I>(its), 0)... };
+        (void) expand;
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline bool zip_view<Cs...>::iterator::any_equal(const iterator &other, std::index_sequence<I...>) const
+    {
+        bool equal[] = { false, (std::get<I>(its) == std::get<I>(other.its))... };
+        return std::find(std::begin(equal),std::end(equal),true) != std::end(equal);
+    }
+
+    template <typename... Cs>
+    zip_view<Cs...>::zip_view(Cs &... cs) : containers(cs...) {}
+
+    template <typename... Cs>
+    inline typename zip_view<Cs...>::iterator zip_view<Cs...>::begin() const
+    {
+        return this->begin(std::index_sequence_for<Cs...>());
+    }
+
+    template <typename... Cs>
+    inline typename zip_view<Cs...>::iterator zip_view<Cs...>::end() const
+    {
+        return this->end(std::index_sequence_for<Cs...>());
+    }
+
+    template <typename... Cs>
+    inline std::size_t zip_view<Cs...>::size() const
+    {
+        return this->size(std::index_sequence_for<Cs...>());
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline typename zip_view<Cs...>::iterator zip_view<Cs...>::begin(std::index_sequence<I...>) const
+    {
+        return iterator(iterators(std::begin(std::get<I>(containers))...));
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline typename zip_view<Cs...>::iterator zip_view<Cs...>::end(std::index_sequence<I...>) const
+    {
+        return iterator(iterators(std::end(std::get<I>(containers))...));
+    }
+
+    template <typename... Cs>
+    template <std::size_t... I>
+    inline std::size_t zip_view<Cs...>::size(std::index_sequence<I...>) const
+    {
+        std::size_t sizes[] = { static_cast<std::size_t>(std::get<I>(containers).size())... };
+        return *std::min_element(std::begin(sizes),std::end(sizes));
+    }
+
+    template <typename... Cs>
+    zip_view<Cs...> zip(Cs &... cs)
+    {
+        return zip_view<Cs...>(cs...);
+    }
+
+    /*
+     * `apply_tuple` calls f with the elements of the tuple `t`.
+     */
+    template <typename F, typename Tuple, std::size_t... I>
+    inline auto apply_tuple(F &f, const Tuple &t, std::index_sequence<I...>)
+        -> decltype(f(std::get<I>(t)...))
+    {
+        return f(std::get<I>(t)...);
+    }
+
+    template <typename F, typename... Cs>
+    fvec<typename std::decay<decltype(std::declval<F &>()(*std::begin(std::declval<Cs &>())...))>::type>
+    zip_with(F f, Cs &... cs)
+    {
+        zip_view<Cs...> view(cs...);
+        fvec<typename std::decay<decltype(f(*std::begin(cs)...))>::type> res;
+        res.reserve(view.size());
+        for (auto const &t: view) {
+            res.push_back(apply_tuple(f,t,std::index_sequence_for<Cs...>()));
+        }
+        return res;
+    }
+
+    template <typename... Vs, std::size_t... I>
+    inline void reserve_columns(std::tuple<Vs...> &columns, std::size_t n, std::index_sequence<I...>)
+    {
+        int expand[] = { 0, (std::get<I>(columns).reserve(n), 0)... };
+        (void) expand;
+    }
+
+    template <typename Tuple, typename... Vs, std::size_t... I>
+    inline void push_components(const Tuple &t, std::tuple<Vs...> &columns, std::index_sequence<I...>)
+    {
+        int expand[] = { 0, (std::get<I>(columns).push_back(std::get<I>(t)), 0)... };
+        (void) expand;
+    }
+
+    template <typename... Ts, typename A>
+    std::tuple<fvec<Ts>...> unzip(const std::vector<std::tuple<Ts...>,A> &vec)
+    {
+        std::tuple<fvec<Ts>...> columns;
+        reserve_columns(columns,vec.size(),std::index_sequence_for<Ts...>());
+        for (auto const &t: vec) {
+            push_components(t,columns,std::index_sequence_for<Ts...>());
+        }
+        return columns;
+    }
+}
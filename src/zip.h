@@ -0,0 +1,136 @@
+/*
+ *  collection/src/zip.h
+ *  library: collection
+ *
+ *  Created by Nicoli Matteo on 19/10/2026.
+ *  Copyright © 2026 Nicoli Matteo.
+ */
+
+#ifndef zip_h
+#define zip_h
+
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+namespace fnc {
+
+    template <typename T>
+    class fvec;
+
+    /*
+     * `zip_view` walks some containers side by side, as long as the
+     * shortest one, yielding the tuples of references to their
+     * corresponding elements. It copies and allocates nothing: the tuples
+     * are built on the fly while iterating.
+     *
+     * WARNING: the view refers to the containers, which must outlive it.
+     */
+    template <typename... Cs>
+    class zip_view {
+
+    public :
+        typedef std::tuple<decltype(std::begin(std::declval<Cs &>()))...> iterators;
+        typedef std::tuple<decltype(*std::begin(std::declval<Cs &>()))...> reference;
+
+        class iterator {
+
+        public :
+            typedef std::forward_iterator_tag iterator_category;
+            typedef std::tuple<typename std::decay<decltype(*std::begin(std::declval<Cs &>()))>::type...> value_type;
+            typedef typename zip_view<Cs...>::reference reference;
+            typedef void pointer;
+            typedef std::ptrdiff_t difference_type;
+
+            iterator(iterators its);
+
+            inline reference operator*() const;
+
+            inline iterator &operator++();
+
+            inline iterator operator++(int);
+
+            /*
+             * Two iterators are equal as soon as one of their components
+             * is, so the iteration stops at the end of the shortest
+             * container.
+             */
+            inline bool operator==(const iterator &other) const;
+
+            inline bool operator!=(const iterator &other) const;
+
+        private :
+            iterators its;
+
+            template <std::size_t... I>
+            inline reference get(std::index_sequence<I...>) const;
+
+            template <std::size_t... I>
+            inline void advance(std::index_sequence<I...>);
+
+            template <std::size_t... I>
+            inline bool any_equal(const iterator &other, std::index_sequence<I...>) const;
+        };
+
+        zip_view(Cs &... cs);
+
+        inline iterator begin() const;
+
+        inline iterator end() const;
+
+        /*
+         * `size` is the length of the shortest container.
+         */
+        inline std::size_t size() const;
+
+    private :
+        std::tuple<Cs &...> containers;
+
+        template <std::size_t... I>
+        inline iterator begin(std::index_sequence<I...>) const;
+
+        template <std::size_t... I>
+        inline iterator end(std::index_sequence<I...>) const;
+
+        template <std::size_t... I>
+        inline std::size_t size(std::index_sequence<I...>) const;
+    };
+
+    /*
+     * `zip` returns the lazy view of the tuples of corresponding elements
+     * of any number of containers, of any types:
+     *
+     *     for (auto t: fnc::zip(ids,prices,names)) {
+     *         std::get<1>(t) *= 2;        // the tuple holds references
+     *     }
+     */
+    template <typename... Cs>
+    zip_view<Cs...> zip(Cs &... cs);
+
+    /*
+     * `zip_with` returns the fvec of f(x,y,...) for the corresponding
+     * elements x, y, ... of the containers, as long as the shortest one.
+     * The result type is the one returned by `f`:
+     *
+     *     fvec<double> totals = fnc::zip_with([](int q, double p) { return q * p; },
+     *                                         quantities,prices);
+     */
+    template <typename F, typename... Cs>
+    fvec<typename std::decay<decltype(std::declval<F &>()(*std::begin(std::declval<Cs &>())...))>::type>
+    zip_with(F f, Cs &... cs);
+
+    /*
+     * `unzip` splits a vector of tuples into one fvec per component,
+     * i.e. from an array of structures into a structure of arrays.
+     */
+    template <typename... Ts, typename A>
+    std::tuple<fvec<Ts>...> unzip(const std::vector<std::tuple<Ts...>,A> &vec);
+
+}
+
+#include "zip.cc"
+
+#endif